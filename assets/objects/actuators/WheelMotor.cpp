@@ -1,5 +1,6 @@
 #include "actuators/WheelMotor.h"
 #include "PhysicsWorld.h"
+#include "VoltageLines.h"
 #include "components/Transforms.h"
 #include "components/RectComponent.h"
 #include "components/Body2D.h"
@@ -28,12 +29,15 @@ WheelMotor::WheelMotor(Scene *scene, const Specification &spec, WheelMotor::Orie
     }
 
     Body2D::Specification bodySpec(true, true, spec.wheelMass + spec.loadedMass, spec.frictionCoefficient);
+    bodySpec.collisionFilter.groupIndex = spec.collisionGroup;
     m_physicsComponent = std::make_unique<Body2D>(*m_physicsWorld, transform, bodySpec);
     m_body2D = static_cast<Body2D *>(m_physicsComponent.get());
+    m_physicsWorld->getVoltageLines()->add(&m_voltageIn);
 }
 
 WheelMotor::~WheelMotor()
 {
+    m_physicsWorld->getVoltageLines()->remove(&m_voltageIn);
 }
 
 std::string WheelMotor::getTextureName(WheelMotor::Orientation orientation, WheelMotor::TextureType textureType) const
@@ -4,6 +4,7 @@
 #include "SceneObject.h"
 #include <glm/glm.hpp>
 #include <string>
+#include <cstdint>
 
 class PhysicsWorld;
 class SpriteAnimation;
@@ -64,6 +65,8 @@ public:
         /** The mass the attached body adds on the wheel  */
         float loadedMass = 0.0f;
         TextureType textureType = TextureType::None;
+        /** See Body2D::CollisionFilter */
+        int16_t collisionGroup = 0;
     };
 
     WheelMotor(Scene *scene, const Specification &spec, Orientation orientation,
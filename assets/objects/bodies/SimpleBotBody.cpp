@@ -71,6 +71,7 @@ void SimpleBotBody::createRectangleBody(const Specification &spec, const glm::ve
 
     /* (The friction is added to the wheels, not the body) */
     Body2D::Specification bodySpec(true, true, spec.mass, 0.0f);
+    bodySpec.collisionFilter.groupIndex = spec.collisionGroup;
     m_physicsComponent = std::make_unique<Body2D>(*m_physicsWorld, transform, bodySpec);
     m_body2D = static_cast<Body2D *>(m_physicsComponent.get());
 }
@@ -101,6 +102,7 @@ void SimpleBotBody::createCircleBody(const Specification &spec, const glm::vec2
 
     /* (The friction is added to the wheels, not the body) */
     Body2D::Specification bodySpec(true, true, spec.mass, 0.0f);
+    bodySpec.collisionFilter.groupIndex = spec.collisionGroup;
     m_physicsComponent = std::make_unique<Body2D>(*m_physicsWorld, transform, bodySpec);
     m_body2D = static_cast<Body2D *>(m_physicsComponent.get());
 }
@@ -110,14 +112,14 @@ void SimpleBotBody::attachWheelMotor(const WheelMotor *wheelMotor, glm::vec2 rel
     m_body2D->attachBodyWithRevoluteJoint(relativePosition, wheelMotor->getBody());
 }
 
-void SimpleBotBody::attachSensor(const RangeSensorObject *rangeSensorObject, glm::vec2 relativePosition)
+void SimpleBotBody::attachSensor(RangeSensorObject *rangeSensorObject, glm::vec2 relativePosition)
 {
-    m_body2D->attachBodyWithWeldJoint(relativePosition, rangeSensorObject->getBody());
+    rangeSensorObject->attach(m_body2D, relativePosition);
 }
 
-void SimpleBotBody::attachSensor(const LineDetectorObject *lineDetectorObject, glm::vec2 relativePosition)
+void SimpleBotBody::attachSensor(LineDetectorObject *lineDetectorObject, glm::vec2 relativePosition)
 {
-    m_body2D->attachBodyWithWeldJoint(relativePosition, lineDetectorObject->getBody());
+    lineDetectorObject->attach(m_body2D, relativePosition);
 }
 
 void SimpleBotBody::onFixedUpdate()
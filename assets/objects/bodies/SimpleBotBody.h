@@ -3,6 +3,7 @@
 
 #include "SceneObject.h"
 #include <glm/glm.hpp>
+#include <cstdint>
 
 class PhysicsWorld;
 class Body2D;
@@ -38,6 +39,8 @@ public:
         float mass;
         Shape shape = Shape::Rectangle;
         TextureType textureType = TextureType::None;
+        /** See Body2D::CollisionFilter */
+        int16_t collisionGroup = 0;
     };
 
     SimpleBotBody(Scene *scene, const Specification &spec, const glm::vec2 &startPosition, float startRotation);
@@ -47,8 +50,9 @@ public:
     float getForwardSpeed() const;
     void onFixedUpdate() override;
     void attachWheelMotor(const WheelMotor *wheelMotor, glm::vec2 relativePosition);
-    void attachSensor(const RangeSensorObject *rangeSensorObject, glm::vec2 relativePosition);
-    void attachSensor(const LineDetectorObject *lineDetectorObject, glm::vec2 relativePosition);
+    /** Sensors are mounted at a pose relative to the body, they don't add any bodies or joints */
+    void attachSensor(RangeSensorObject *rangeSensorObject, glm::vec2 relativePosition);
+    void attachSensor(LineDetectorObject *lineDetectorObject, glm::vec2 relativePosition);
     void setMass(float mass);
     float getMass() const;
 
@@ -1,5 +1,6 @@
 #include "playgrounds/Dohyo.h"
 #include "PhysicsWorld.h"
+#include "FloorMap.h"
 #include "components/Transforms.h"
 #include "components/Body2D.h"
 #include "components/HollowCircleComponent.h"
@@ -12,8 +13,14 @@ Dohyo::Dohyo(Scene *scene, const Specification &spec, const glm::vec2 &position)
     assert(m_physicsWorld->getGravityType() == PhysicsWorld::Gravity::TopView);
     m_transformComponent = std::make_unique<HollowCircleTransform>(position, spec.innerRadius, spec.outerRadius);
     const auto transform = static_cast<HollowCircleTransform *>(m_transformComponent.get());
-    m_physicsComponent = std::make_unique<Body2D>(*m_physicsWorld, transform, Body2D::Specification{ false, false, 0.0f });
-    static_cast<Body2D *>(m_physicsComponent.get())->setUserData(&m_userData);
+    Body2D::Specification bodySpec(false, false, 0.0f);
+    bodySpec.collisionFilter = Body2D::CollisionFilter::detectable();
+    m_physicsComponent = std::make_unique<Body2D>(*m_physicsWorld, transform, bodySpec);
+    m_body2D = static_cast<Body2D *>(m_physicsComponent.get());
+    m_body2D->setUserData(&m_userData);
+    if (FloorMap *floorMap = m_physicsWorld->getFloorMap()) {
+        floorMap->addRing(*m_body2D->getRing());
+    }
 
     switch (spec.textureType) {
     case Dohyo::TextureType::Scratched:
@@ -40,3 +47,18 @@ Dohyo::~Dohyo()
 void Dohyo::onFixedUpdate()
 {
 }
+
+bool Dohyo::isOutside(const glm::vec2 &position) const
+{
+    return m_body2D->getRing()->isOutside(position);
+}
+
+bool Dohyo::isOnBorder(const glm::vec2 &position) const
+{
+    return m_body2D->getRing()->contains(position);
+}
+
+float Dohyo::getDistanceFromCenter(const glm::vec2 &position) const
+{
+    return m_body2D->getRing()->getDistanceFromCenter(position);
+}
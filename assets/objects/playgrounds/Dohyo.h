@@ -7,6 +7,7 @@
 
 class PhysicsWorld;
 class RectObject;
+class Body2D;
 
 /**
  * A sumobot dohyo (circular arena) with a detectable border and adjustable dimensions.
@@ -23,10 +24,16 @@ public:
     Dohyo(Scene *scene, const Specification &spec, const glm::vec2 &position);
     ~Dohyo();
     void onFixedUpdate() override;
+    /** True if the position is outside the dohyo (beyond the border), i.e. ring-out */
+    bool isOutside(const glm::vec2 &position) const;
+    /** True if the position is on the border */
+    bool isOnBorder(const glm::vec2 &position) const;
+    float getDistanceFromCenter(const glm::vec2 &position) const;
 
 private:
-    Body2DUserData m_userData = { 0, 0, BodyId::Detectable };
+    Body2DUserData m_userData = { BodyId::Detectable };
     std::unique_ptr<RectObject> m_quadObject;
+    Body2D *m_body2D = nullptr;
 };
 
 #endif /* DOHYO_H_ */
@@ -2,6 +2,8 @@
 #include "shapes/QuadObject.h"
 #include "SceneObject.h"
 #include "Renderer.h"
+#include "PhysicsWorld.h"
+#include "FloorMap.h"
 
 #include <unordered_map>
 #include <vector>
@@ -117,8 +119,14 @@ LineFollowerPath::LineFollowerPath(Scene *scene, const glm::vec4 &lineColor,
 {
     const auto quadCoords = getRightAnglePathQuadCoords(pathPoints, lineWidth);
     const Body2D::Specification bodySpec;
+    /* With a floor map, the quads are drawn on it instead of being detectable bodies */
+    FloorMap *floorMap = m_physicsWorld->getFloorMap();
     for (const auto &quadCoord : quadCoords) {
-        m_pathQuads.push_back(std::make_unique<QuadObject>(scene, quadCoord, lineColor, &bodySpec, true));
+        if (floorMap != nullptr) {
+            floorMap->addQuad(quadCoord);
+        }
+        m_pathQuads.push_back(std::make_unique<QuadObject>(scene, quadCoord, lineColor,
+                                                           floorMap ? nullptr : &bodySpec, true));
     }
 }
 
@@ -30,6 +30,7 @@ BaseBot::BaseBot(Scene *scene, const BaseBot::Specification &spec,
     SceneObject(scene)
 {
     sanityCheckSpec(spec);
+    m_collisionGroup = m_physicsWorld->createCollisionGroup();
     createBody(spec, startPosition, startRotation);
     createWheelMotors(spec);
     createSensors(spec);
@@ -41,8 +42,9 @@ BaseBot::~BaseBot()
 
 void BaseBot::createBody(const BaseBot::Specification &spec, const glm::vec2 &startPosition, float startRotation)
 {
-    const SimpleBotBody::Specification bodySpec(spec.bodyLength, spec.bodyWidth, spec.bodyMass,
-                                              spec.bodyShape, spec.bodyTexture);
+    SimpleBotBody::Specification bodySpec(spec.bodyLength, spec.bodyWidth, spec.bodyMass,
+                                          spec.bodyShape, spec.bodyTexture);
+    bodySpec.collisionGroup = m_collisionGroup;
     m_body = std::make_unique<SimpleBotBody>(m_scene, bodySpec, startPosition, startRotation);
 }
 
@@ -50,10 +52,11 @@ void BaseBot::createWheelMotors(const BaseBot::Specification &spec)
 {
     const int wheelCount = spec.wheelMotorTuples.size();
     const float loadedMass = spec.bodyMass / wheelCount;
-    const WheelMotor::Specification wheelSpec(spec.motorVoltageInConstant, spec.motorAngularSpeedConstant,
-                                              spec.motorMaxVoltage, spec.wheelFrictionCoefficient, spec.wheelSidewayFrictionConstant,
-                                              spec.wheelWidth, spec.wheelDiameter, spec.wheelMass, loadedMass,
-                                              spec.wheelTexture);
+    WheelMotor::Specification wheelSpec(spec.motorVoltageInConstant, spec.motorAngularSpeedConstant,
+                                        spec.motorMaxVoltage, spec.wheelFrictionCoefficient, spec.wheelSidewayFrictionConstant,
+                                        spec.wheelWidth, spec.wheelDiameter, spec.wheelMass, loadedMass,
+                                        spec.wheelTexture);
+    wheelSpec.collisionGroup = m_collisionGroup;
     for (const auto &wheelMotorTuple : spec.wheelMotorTuples) {
         const auto index = std::get<0>(wheelMotorTuple);
         const auto relativePosition = std::get<1>(wheelMotorTuple);
@@ -140,7 +143,7 @@ float *BaseBot::getVoltageLine(BaseBot::LineDetectorIndex lineDetectorIndex) con
 void BaseBot::onFixedUpdate()
 {
     /* Only do callbacks every 10 ms (100 times per second) */
-    const auto millisecondsSinceStart = m_scene->getMillisecondsSinceStart();
+    const auto millisecondsSinceStart = m_scene->getSimulatedMilliseconds();
     const float epsilon = 0.01f;
     if (millisecondsSinceStart - m_lastCallbackTime > 10) {
         const auto forwardSpeed = getForwardSpeed();
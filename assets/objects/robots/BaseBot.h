@@ -87,6 +87,8 @@ private:
     void createWheelMotors(const Specification &spec);
     void createSensors(const Specification &spec);
 
+    /** Shared by the body and wheels, so the parts of the bot don't make contacts */
+    int16_t m_collisionGroup = 0;
     std::unique_ptr<SimpleBotBody> m_body;
     std::unordered_map<WheelMotorIndex, std::unique_ptr<WheelMotor>> m_wheelMotors;
     std::unordered_map<RangeSensorIndex, std::unique_ptr<RangeSensorObject>> m_rangeSensors;
@@ -12,7 +12,10 @@
 PhysicsBot::PhysicsBot(Scene *scene, const glm::vec2 &size, const glm::vec2 &startPosition, const float startRotation) :
     SceneObject(scene), m_frictionCoefficient(0.1f), m_bodyMass(0.4f), m_wheelMass(0.025f), m_wheelCount(4)
 {
+    /* The body and wheels share a group, so they don't make contacts with each other */
+    const int16_t collisionGroup = m_physicsWorld->createCollisionGroup();
     Body2D::Specification mainBodySpec(true, true, m_bodyMass, 0.0f);
+    mainBodySpec.collisionFilter.groupIndex = collisionGroup;
     m_transformComponent = std::make_unique<RectTransform>(startPosition, size, startRotation);
     const auto transform = static_cast<RectTransform *>(m_transformComponent.get());
     m_physicsComponent = std::make_unique<Body2D>(*m_physicsWorld, transform, mainBodySpec);
@@ -22,6 +25,7 @@ PhysicsBot::PhysicsBot(Scene *scene, const glm::vec2 &size, const glm::vec2 &sta
     auto wheelColor = glm::vec4{1.0f, 0.0f, 0.0f, 1.0f};
     Body2D::Specification wheelSpec(true, true, getLoadedWheelMass());
     wheelSpec.frictionCoefficient = m_frictionCoefficient;
+    wheelSpec.collisionFilter.groupIndex = collisionGroup;
     glm::vec2 wheelSize{0.015, 0.02};
     glm::vec2 wheelPosFrontRight{((size.x + 0.015f) / 2.0f), size.y/4.0f};
     glm::vec2 wheelPosBackRight{((size.x + 0.015f) / 2.0f), -size.y/4.0f};
@@ -56,7 +60,7 @@ void PhysicsBot::onFixedUpdate()
 
     const float epsilon = 0.001f;
     /* Only do callbacks every 10 ms (100 times per second) */
-    const auto millisecondsSinceStart = m_scene->getMillisecondsSinceStart();
+    const auto millisecondsSinceStart = m_scene->getSimulatedMilliseconds();
     if (millisecondsSinceStart - m_lastCallbackTime > 10) {
         const auto forwardSpeed = getForwardSpeed();
         if (fabs(forwardSpeed) > (epsilon + fabs(m_recordedTopSpeed))) {
@@ -2,7 +2,6 @@
 #include "components/LineDetector.h"
 #include "components/Transforms.h"
 #include "components/CircleComponent.h"
-#include "components/Body2D.h"
 
 #include <glm/glm.hpp>
 
@@ -24,9 +23,9 @@ LineDetectorObject::~LineDetectorObject()
 {
 }
 
-Body2D *LineDetectorObject::getBody() const
+void LineDetectorObject::attach(const Body2D *hostBody, const glm::vec2 &relativePosition)
 {
-    return m_lineDetector->getBody();
+    m_lineDetector->attach(hostBody, relativePosition);
 }
 
 float *LineDetectorObject::getVoltageLine() const
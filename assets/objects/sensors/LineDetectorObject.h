@@ -16,7 +16,8 @@ public:
     LineDetectorObject(Scene *scene, bool debugDraw,
                        const glm::vec2 &startPosition = { 0.0f, 0.0f });
     ~LineDetectorObject();
-    Body2D *getBody() const;
+    /** Mounts the sensor on a host body (no Box2D body or joint is created) */
+    void attach(const Body2D *hostBody, const glm::vec2 &relativePosition);
     void onFixedUpdate() override;
     float *getVoltageLine() const;
     void setDebugDraw(bool enable);
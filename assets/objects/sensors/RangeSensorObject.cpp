@@ -30,9 +30,9 @@ void RangeSensorObject::setDebugDraw(bool enabled)
     m_renderableComponent->setEnabled(enabled);
 }
 
-Body2D *RangeSensorObject::getBody() const
+void RangeSensorObject::attach(const Body2D *hostBody, const glm::vec2 &relativePosition)
 {
-    return m_rangeSensor->getBody();
+    m_rangeSensor->attach(hostBody, relativePosition);
 }
 
 float *RangeSensorObject::getVoltageLine() const
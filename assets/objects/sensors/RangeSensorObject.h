@@ -22,7 +22,8 @@ public:
                       const glm::vec2 startPosition = { 0.0f, 0.0f });
     ~RangeSensorObject();
     void setDebugDraw(bool enabled);
-    Body2D *getBody() const;
+    /** Mounts the sensor on a host body (no Box2D body or joint is created) */
+    void attach(const Body2D *hostBody, const glm::vec2 &relativePosition);
     void onFixedUpdate() override;
     float *getVoltageLine() const;
 
@@ -9,7 +9,11 @@ QuadObject::QuadObject(Scene *scene, const QuadCoords &quadCoords, const glm::ve
     m_transformComponent = std::make_unique<QuadTransform>(quadCoords);
     auto transform = static_cast<QuadTransform *>(m_transformComponent.get());
     if (spec != nullptr) {
-        m_physicsComponent = std::make_unique<Body2D>(*m_physicsWorld, transform, *spec);
+        Body2D::Specification bodySpec = *spec;
+        if (detectable) {
+            bodySpec.collisionFilter = Body2D::CollisionFilter::detectable();
+        }
+        m_physicsComponent = std::make_unique<Body2D>(*m_physicsWorld, transform, bodySpec);
         m_body2D = static_cast<Body2D *>(m_physicsComponent.get());
         if (detectable) {
             m_body2D->setUserData(&m_userData);
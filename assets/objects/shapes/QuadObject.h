@@ -19,7 +19,7 @@ public:
     QuadObject(Scene *scene, const QuadCoords &quadCoords, const glm::vec4 &color,
                const Body2D::Specification *spec, bool detectable);
 private:
-    Body2DUserData m_userData = { 0, 0, BodyId::Detectable };
+    Body2DUserData m_userData = { BodyId::Detectable };
     Body2D *m_body2D;
 };
 
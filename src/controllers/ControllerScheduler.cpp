@@ -0,0 +1,86 @@
+#include "ControllerScheduler.h"
+#include "components/Microcontroller.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+namespace {
+/* A controller typically runs for a few microseconds before it sleeps again, so fewer
+ * controllers per job than this aren't worth waking up the worker threads for */
+const unsigned int controllersPerJob = 4;
+}
+
+ControllerScheduler::ControllerScheduler() :
+    m_threadPool(&ThreadPool::getShared())
+{
+}
+
+void ControllerScheduler::addController(Microcontroller *microcontroller)
+{
+    assert(microcontroller != nullptr);
+    assert(m_registrations.count(microcontroller) == 0);
+    const uint64_t registration = ++m_registrationCount;
+    m_registrations[microcontroller] = registration;
+    m_wakeups.push({ m_elapsedSeconds, registration, microcontroller });
+}
+
+void ControllerScheduler::removeController(Microcontroller *microcontroller)
+{
+    /* Its wakeup is left in the queue and skipped when it's due */
+    m_registrations.erase(microcontroller);
+}
+
+void ControllerScheduler::setThreadPool(ThreadPool *threadPool)
+{
+    m_threadPool = threadPool;
+}
+
+void ControllerScheduler::step(float stepTime)
+{
+    m_elapsedSeconds += stepTime;
+    m_dueControllers.clear();
+    while (!m_wakeups.empty() && m_wakeups.top().time <= m_elapsedSeconds) {
+        const Wakeup wakeup = m_wakeups.top();
+        m_wakeups.pop();
+        const auto registrationItr = m_registrations.find(wakeup.microcontroller);
+        if (registrationItr != m_registrations.end() && registrationItr->second == wakeup.registration) {
+            m_dueControllers.push_back(wakeup);
+        }
+    }
+    if (m_dueControllers.empty()) {
+        return;
+    }
+
+    runDueControllers();
+
+    for (size_t i = 0; i < m_dueControllers.size(); i++) {
+        /* Infinity means main has returned */
+        if (m_sleepSeconds[i] != std::numeric_limits<double>::infinity()) {
+            Wakeup &wakeup = m_dueControllers[i];
+            wakeup.time = m_elapsedSeconds + m_sleepSeconds[i];
+            m_wakeups.push(wakeup);
+        }
+    }
+}
+
+void ControllerScheduler::runDueControllers()
+{
+    const unsigned int dueCount = static_cast<unsigned int>(m_dueControllers.size());
+    m_sleepSeconds.resize(dueCount);
+    if (m_threadPool == nullptr || dueCount < 2 * controllersPerJob) {
+        for (unsigned int i = 0; i < dueCount; i++) {
+            m_sleepSeconds[i] = m_dueControllers[i].microcontroller->runUntilSleep();
+        }
+        return;
+    }
+
+    const unsigned int jobCount = (dueCount + controllersPerJob - 1) / controllersPerJob;
+    m_threadPool->parallelFor(jobCount, [this, dueCount](unsigned int job) {
+        const unsigned int end = std::min((job + 1) * controllersPerJob, dueCount);
+        for (unsigned int i = job * controllersPerJob; i < end; i++) {
+            m_sleepSeconds[i] = m_dueControllers[i].microcontroller->runUntilSleep();
+        }
+    });
+}
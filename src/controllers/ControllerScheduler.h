@@ -0,0 +1,63 @@
+#ifndef CONTROLLER_SCHEDULER_H_
+#define CONTROLLER_SCHEDULER_H_
+
+#include <vector>
+#include <queue>
+#include <unordered_map>
+#include <cstdint>
+
+class Microcontroller;
+class ThreadPool;
+
+/**
+ * Runs the coroutines of many microcontrollers (see Microcontroller::ExecutionMode) on
+ * the threads of a ThreadPool, instead of one thread per controller or one after another
+ * on the simulation thread. The number of controllers is then independent of the number
+ * of cores. Controllers in lockstep mode can be scheduled too, they then skip the steps
+ * they sleep through, but still run on their own threads.
+ *
+ * Controllers are kept in a queue ordered by the simulated time they wake up at, so a
+ * sleeping controller costs nothing until its sleep is over. The controllers that wake up at the
+ * same step run in parallel, handed out to the threads as they become free. A controller
+ * only touches its own voltage lines, so the result doesn't depend on the order.
+ *
+ * A controller may be resumed on a different thread each time it wakes up, so its code
+ * must not rely on thread-local state across sleeps.
+ *
+ * Each Scene has one, see Scene::getControllerScheduler and Microcontroller::setScheduler.
+ */
+class ControllerScheduler
+{
+public:
+    ControllerScheduler();
+    /** The controller runs first at the next step */
+    void addController(Microcontroller *microcontroller);
+    void removeController(Microcontroller *microcontroller);
+    /** Null runs the controllers serially, defaults to ThreadPool::getShared() */
+    void setThreadPool(ThreadPool *threadPool);
+    /** Runs the controllers whose sleep is over, called by the Scene every step */
+    void step(float stepTime);
+
+private:
+    struct Wakeup {
+        double time;
+        /** Tells apart a controller that is removed and then added again */
+        uint64_t registration;
+        Microcontroller *microcontroller;
+        bool operator>(const Wakeup &other) const
+        {
+            return time != other.time ? time > other.time : registration > other.registration;
+        }
+    };
+    void runDueControllers();
+
+    std::priority_queue<Wakeup, std::vector<Wakeup>, std::greater<Wakeup>> m_wakeups;
+    std::unordered_map<Microcontroller *, uint64_t> m_registrations;
+    std::vector<Wakeup> m_dueControllers;
+    std::vector<double> m_sleepSeconds;
+    ThreadPool *m_threadPool = nullptr;
+    double m_elapsedSeconds = 0.0;
+    uint64_t m_registrationCount = 0;
+};
+
+#endif /* CONTROLLER_SCHEDULER_H_ */
@@ -1,9 +1,22 @@
 #include "components/Microcontroller.h"
+#include "Tracer.h"
+#include "Fiber.h"
+#include "ControllerScheduler.h"
 
+#include <algorithm>
+#include <limits>
 #include <cassert>
 #include <chrono>
 #include <thread>
 #include <iostream>
+#include <string>
+
+namespace {
+/* For naming the threads in traces */
+std::atomic<unsigned int> s_threadCount = 0;
+static_assert(std::atomic<float>::is_always_lock_free, "Voltage levels must be lock-free");
+static_assert(std::atomic<double>::is_always_lock_free, "Simulated time must be lock-free");
+}
 
 Microcontroller::Microcontroller(Microcontroller::VoltageLines &voltageLines) :
     m_simulatorVoltageLines(voltageLines)
@@ -12,8 +25,18 @@ Microcontroller::Microcontroller(Microcontroller::VoltageLines &voltageLines) :
 
 Microcontroller::~Microcontroller()
 {
-    m_running = false;
-    m_sleepSteps = 0;
+    if (m_scheduler != nullptr) {
+        m_scheduler->removeController(this);
+    }
+    if (m_executionMode == ExecutionMode::Coroutine) {
+        /* The fiber is never resumed again, so main is simply abandoned together with
+         * its stack (like cutting the power to a real microcontroller) */
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lockGuard(m_mutexSteps);
+        m_running = false;
+    }
     /* Make sure we signal in case the thread is blocking */
     m_conditionWake.notify_one();
     if (m_thread.joinable()) {
@@ -23,59 +46,152 @@ Microcontroller::~Microcontroller()
     }
 }
 
+void Microcontroller::setExecutionMode(ExecutionMode executionMode)
+{
+    assert(!m_microcontrollerStarted);
+    m_executionMode = executionMode;
+}
+
+void Microcontroller::setScheduler(ControllerScheduler *scheduler)
+{
+    assert(m_executionMode != ExecutionMode::Thread);
+    assert(!m_microcontrollerStarted);
+    m_scheduler = scheduler;
+}
+
 void Microcontroller::start()
 {
     m_microcontrollerStarted = true;
-    /* We need a separate function for starting the microcontroller because
-     * we can't create/start inside the constructor when the object is not yet
-     * fully created. Also, make sure we don't start it before the physics
-     * has started. */
-    if (m_physicsStarted) {
-        m_thread = std::thread(&Microcontroller::microcontrollerThreadFn, this);
+    if (m_executionMode == ExecutionMode::Coroutine) {
+        /* Runs on the first step */
+        m_fiber = std::make_unique<Fiber>([this] {
+            m_runStartTime = Tracer::now();
+            main();
+            m_mainFinished = true;
+        });
+    } else if (m_executionMode == ExecutionMode::Thread && m_physicsStarted) {
+        /* We need a separate function for starting the microcontroller because
+         * we can't create/start inside the constructor when the object is not yet
+         * fully created. Also, make sure we don't start it before the physics
+         * has started. In lockstep mode, the thread is started on the first step. */
+        startThread();
     }
+    if (m_scheduler != nullptr) {
+        m_scheduler->addController(this);
+    }
+}
+
+void Microcontroller::startThread()
+{
+    m_thread = std::thread(&Microcontroller::microcontrollerThreadFn, this);
 }
 
-void Microcontroller::transferVoltageLevels()
+void Microcontroller::transferInputLevels()
 {
-    m_voltageLinesMutex.lock();
     for (int i = 0; i < Microcontroller::VoltageLine::Idx::Count; i++) {
-        if (m_simulatorVoltageLines[i].level == nullptr) {
-            /* Skip unused lines */
-            continue;
+        if (m_simulatorVoltageLines[i].level != nullptr &&
+            m_simulatorVoltageLines[i].type == Microcontroller::VoltageLine::Type::Input) {
+            m_microcontrollerVoltageLineLevels[i].store(*m_simulatorVoltageLines[i].level, std::memory_order_relaxed);
         }
-        if (m_simulatorVoltageLines[i].type == Microcontroller::VoltageLine::Type::Output) {
-            *m_simulatorVoltageLines[i].level = m_microcontrollerVoltageLineLevels[i];
-        } else {
-            m_microcontrollerVoltageLineLevels[i] = *m_simulatorVoltageLines[i].level;
+    }
+}
+
+void Microcontroller::transferOutputLevels()
+{
+    if (m_dirtyVoltageLines.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+    const uint32_t dirtyVoltageLines = m_dirtyVoltageLines.exchange(0, std::memory_order_acquire);
+    for (int i = 0; i < Microcontroller::VoltageLine::Idx::Count; i++) {
+        if ((dirtyVoltageLines & (1u << i)) && m_simulatorVoltageLines[i].level != nullptr &&
+            m_simulatorVoltageLines[i].type == Microcontroller::VoltageLine::Type::Output) {
+            *m_simulatorVoltageLines[i].level = m_microcontrollerVoltageLineLevels[i].load(std::memory_order_relaxed);
         }
     }
-    m_voltageLinesMutex.unlock();
 }
 
 /* Called by the simulator update loop, keep it short to avoid affecting
  * the frame rate. */
 void Microcontroller::onFixedUpdate(float stepTime)
 {
+    Tracer::ScopedSpan span("Microcontroller::onFixedUpdate");
     m_physicsStarted = true;
+    m_currentStepTime.store(stepTime, std::memory_order_relaxed);
+    const double previousElapsedSeconds = m_elapsedSeconds.load(std::memory_order_relaxed);
+    const double elapsedSeconds = previousElapsedSeconds + stepTime;
+    m_elapsedSeconds = elapsedSeconds;
+    if (m_executionMode == ExecutionMode::Thread) {
+        updateThread(previousElapsedSeconds, elapsedSeconds);
+        return;
+    }
+    if (m_scheduler != nullptr) {
+        /* The scheduler runs it */
+        return;
+    }
+    if (elapsedSeconds < m_wakeTime.load(std::memory_order_relaxed) || !m_microcontrollerStarted || m_mainFinished) {
+        return;
+    }
+    runUntilSleep();
+}
 
-    /* Check if controller code has requested to sleep for X physics steps,
-     * and if it has, count the steps and wake it up afterwards */
-    std::unique_lock<std::mutex> uniqueLock(m_mutexSteps);
-    m_currentStepTime = stepTime;
-    if (m_sleepSteps > 0) {
-        m_sleepSteps--;
-        if (m_sleepSteps == 0) {
+/**
+ * The controller thread runs freely while awake, so the inputs are copied every step
+ * then, but not while it sleeps. The outputs only change while it's awake, and are
+ * copied when the controller has written them. The mutex is only taken on the step the
+ * controller wakes up at, so a sleeping controller costs a few loads per step.
+ */
+void Microcontroller::updateThread(double previousElapsedSeconds, double elapsedSeconds)
+{
+    transferOutputLevels();
+    const double wakeTime = m_wakeTime;
+    if (elapsedSeconds >= wakeTime) {
+        transferInputLevels();
+        if (previousElapsedSeconds < wakeTime) {
+            /* Under the lock, or the controller may miss it if it's about to wait */
+            std::lock_guard<std::mutex> lockGuard(m_mutexSteps);
             m_conditionWake.notify_one();
         }
     }
-    m_stepsTaken++;
-    uniqueLock.unlock();
+    if (!m_thread.joinable() && m_microcontrollerStarted) {
+        startThread();
+    }
+}
 
+/**
+ * Nothing else touches the voltage lines while the controller runs in coroutine and
+ * lockstep mode, so it's enough to transfer them around the run.
+ */
+double Microcontroller::runUntilSleep()
+{
+    assert(m_microcontrollerStarted && !m_mainFinished);
+    transferInputLevels();
+    if (m_executionMode == ExecutionMode::Coroutine) {
+        m_fiber->resume();
+    } else {
+        runLockstep();
+    }
+    transferOutputLevels();
+    if (m_mainFinished) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return m_wakeTime.load(std::memory_order_relaxed) - m_elapsedSeconds.load(std::memory_order_relaxed);
+}
 
-    transferVoltageLevels();
-    if (!m_thread.joinable() && m_microcontrollerStarted) {
-        start();
+/**
+ * Hands the turn to the controller thread and waits until it sleeps again, so the
+ * controller never runs concurrently with the simulation.
+ */
+void Microcontroller::runLockstep()
+{
+    std::unique_lock<std::mutex> uniqueLock(m_mutexSteps);
+    m_lockstepTurn = true;
+    if (m_thread.joinable()) {
+        m_conditionWake.notify_one();
+    } else {
+        startThread();
     }
+    Tracer::ScopedSpan waitSpan("Wait for controller");
+    m_conditionSleep.wait(uniqueLock, [this] { return !m_lockstepTurn || m_mainFinished; });
 }
 
 void Microcontroller::microcontrollerThreadFn()
@@ -87,10 +203,15 @@ void Microcontroller::microcontrollerThreadFn()
      * variable in the C callback functions and throw an exception if it's false. Note,
      * for this to work, the main function must call the C callback functions
      * regularly. */
+    Tracer::setThreadName("Microcontroller " + std::to_string(s_threadCount++));
+    m_runStartTime = Tracer::now();
     try {
         main();
     } catch (int e) {
     }
+    std::lock_guard<std::mutex> lockGuard(m_mutexSteps);
+    m_mainFinished = true;
+    m_conditionSleep.notify_one();
 }
 
 void Microcontroller::onKeyEvent(const Event::Key &keyEvent)
@@ -100,11 +221,9 @@ void Microcontroller::onKeyEvent(const Event::Key &keyEvent)
 
 float Microcontroller::getVoltageLevel(int idx)
 {
-    m_voltageLinesMutex.lock();
     assert(idx >= 0);
-    assert(idx <= VoltageLine::Idx::Count);
-    float level = m_microcontrollerVoltageLineLevels[idx];
-    m_voltageLinesMutex.unlock();
+    assert(idx < VoltageLine::Idx::Count);
+    const float level = m_microcontrollerVoltageLineLevels[idx].load(std::memory_order_relaxed);
     if (!m_running) {
         throw 0;
     }
@@ -120,11 +239,10 @@ float get_voltage_cb(int idx, void *userdata)
 
 void Microcontroller::setVoltageLevel(int idx, float level)
 {
-    m_voltageLinesMutex.lock();
     assert(idx >= 0);
-    assert(idx <= VoltageLine::Idx::Count);
-    m_microcontrollerVoltageLineLevels[idx] = level;
-    m_voltageLinesMutex.unlock();
+    assert(idx < VoltageLine::Idx::Count);
+    m_microcontrollerVoltageLineLevels[idx].store(level, std::memory_order_relaxed);
+    m_dirtyVoltageLines.fetch_or(1u << idx, std::memory_order_release);
     if (!m_running) {
         throw 0;
     }
@@ -139,9 +257,30 @@ void set_voltage_cb(int idx, float level, void *userdata)
 
 void Microcontroller::msSleep(int sleep_ms)
 {
-    std::unique_lock<std::mutex> uniqueLock(m_mutexSteps);
-    m_sleepSteps = sleep_ms / (m_currentStepTime * 1000);
-    m_conditionWake.wait(uniqueLock, [this] { return m_sleepSteps == 0; });
+    const int64_t sleepStartTime = Tracer::now();
+    Tracer::recordSpan("Run", m_runStartTime, sleepStartTime);
+    /* Wake up at the step that ends closest to the requested time, so the rounding
+     * errors of the summed step times don't add a step to every sleep */
+    const double wakeTime = m_elapsedSeconds + sleep_ms / 1000.0 - 0.5 * m_currentStepTime.load(std::memory_order_relaxed);
+    if (m_executionMode == ExecutionMode::Coroutine) {
+        /* Resumed from a later step, so it sleeps at least one step even if the wake
+         * time has passed, or a main loop that sleeps would never return control */
+        m_wakeTime.store(wakeTime, std::memory_order_relaxed);
+        Fiber::yield();
+    } else if (m_executionMode == ExecutionMode::Lockstep) {
+        /* Waits for the next turn, which is at least one step away like in coroutine mode */
+        std::unique_lock<std::mutex> uniqueLock(m_mutexSteps);
+        m_wakeTime = wakeTime;
+        m_lockstepTurn = false;
+        m_conditionSleep.notify_one();
+        m_conditionWake.wait(uniqueLock, [this] { return m_lockstepTurn || !m_running; });
+    } else {
+        std::unique_lock<std::mutex> uniqueLock(m_mutexSteps);
+        m_wakeTime = wakeTime;
+        m_conditionWake.wait(uniqueLock, [this] { return m_elapsedSeconds >= m_wakeTime || !m_running; });
+    }
+    m_runStartTime = Tracer::now();
+    Tracer::recordSpan("Sleep", sleepStartTime, m_runStartTime);
     if (!m_running) {
         throw 0;
     }
@@ -166,6 +305,5 @@ uint32_t Microcontroller::timeMs()
     if (!m_running) {
         throw 0;
     }
-    std::unique_lock<std::mutex> uniqueLock(m_mutexSteps);
-    return 1000 * m_stepsTaken * m_currentStepTime;
+    return 1000 * m_elapsedSeconds.load(std::memory_order_relaxed);
 }
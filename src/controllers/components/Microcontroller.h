@@ -21,13 +21,18 @@ uint32_t time_ms_cb(void *userdata);
 #include <atomic>
 #include <thread>
 #include <mutex>
+#include <memory>
 #include <condition_variable>
+
+class Fiber;
+class ControllerScheduler;
+
 /**
  * Base class for mimicking a real microcontroller.
  *
- * The execution of the microcontroller is offloaded to a separate thread to prevent
- * the simulator's update rate from depending on the microcontroller's update rate
- * (or vice versa).
+ * By default, the execution of the microcontroller is offloaded to a separate thread to
+ * prevent the simulator's update rate from depending on the microcontroller's update rate
+ * (or vice versa). Alternatively, main can run as a coroutine (see ExecutionMode).
  *
  * This class must be inherited and the inheritor must implement main.
  */
@@ -54,6 +59,22 @@ public:
     };
     typedef std::array<VoltageLine, VoltageLine::Idx::Count> VoltageLines;
 
+    /**
+     * Thread runs main in its own thread, which the simulation wakes up through a
+     * condition variable when a sleep is over. Coroutine runs main as a fiber (see Fiber)
+     * on the simulation thread instead, resumed from onFixedUpdate when a sleep is over.
+     * It avoids two context switches per controller and step, and the controller then
+     * behaves exactly the same every run. Each sleep lasts at least one step in this mode,
+     * and main must sleep regularly, because the simulation waits while it runs.
+     *
+     * Lockstep runs main in its own thread too, but the simulation waits for it to sleep
+     * again after waking it up, so its code runs at the same point of every step, as in
+     * Coroutine mode. Runs are then reproducible, at the cost of two context switches per
+     * wakeup. Use it for controllers that can't run as a fiber, e.g. when they need a
+     * large stack or thread-local state, or to step through them in a debugger.
+     */
+    enum class ExecutionMode { Thread, Coroutine, Lockstep };
+
     /**
      * \param voltageLines List of voltage lines that may be connected to "electrical" objects.
      * Users must manually keep track of which voltage lines are connected to what objects.
@@ -61,6 +82,18 @@ public:
     Microcontroller(VoltageLines &voltageLines);
     ~Microcontroller();
 
+    /**
+     * Must be called before start()
+     */
+    void setExecutionMode(ExecutionMode executionMode);
+    ExecutionMode getExecutionMode() const { return m_executionMode; }
+    /**
+     * Coroutine and lockstep mode only. Lets the scheduler run the controller when its
+     * sleep is over, in parallel with other controllers, instead of running it from
+     * onFixedUpdate (see ControllerScheduler). Must be called before start().
+     */
+    void setScheduler(ControllerScheduler *scheduler);
+
     /**
      * Must be called to start the loop function.
      */
@@ -85,8 +118,8 @@ public:
     void setVoltageLevel(int idx, float level);
 
     /**
-     * Calculates and sleeps for the number of physics steps contained
-     * in sleep_ms milliseconds.
+     * Sleeps until sleep_ms milliseconds of simulated time have passed, rounded to the
+     * nearest step (the step time may change meanwhile).
      *
      * NOTE: The precision is determined by how small the physics step time is.
      *       A smaller step time means better precision.
@@ -95,7 +128,8 @@ public:
     void msSleep(int sleep_ms);
 
     /**
-     * Get the time elapsed from the number of physics steps taken
+     * Get the time elapsed from the physics steps taken (the sum of their step times,
+     * which may vary when the simulation is overloaded)
      */
     uint32_t timeMs();
 
@@ -105,23 +139,45 @@ private:
 
     /** Thread function that runs the microcontroller loop */
     void microcontrollerThreadFn();
+    void startThread();
+    /** onFixedUpdate in thread execution mode */
+    void updateThread(double previousElapsedSeconds, double elapsedSeconds);
+    void runLockstep();
+    /**
+     * Coroutine and lockstep mode only. Runs main until it sleeps again or returns.
+     *
+     * \return The simulated seconds until it wakes up (zero or less for the next step),
+     * infinity if main has returned
+     */
+    double runUntilSleep();
+    friend class ControllerScheduler;
 
     /** The voltage lines which the simulator objects (e.g. sumobot, wheel motor) writes to and read from */
     VoltageLines m_simulatorVoltageLines;
+    ExecutionMode m_executionMode = ExecutionMode::Thread;
     std::thread m_thread;
+    std::unique_ptr<Fiber> m_fiber;
+    ControllerScheduler *m_scheduler = nullptr;
     std::atomic<bool> m_running = true;
     bool m_physicsStarted = false;
     bool m_microcontrollerStarted = false;
+    bool m_mainFinished = false;
 
     /**
      * Since the simulator and microcontroller code runs in separate threads, we must separate the voltage
      * lines to avoid race conditions. Do this by creating a separate voltage level array that the microcontroller
-     * can write freely to, and synchronize it (safely with mutex) with the Simulator's voltage lines every
-     * simulation iteration.
+     * can write freely to, and synchronize it with the Simulator's voltage lines every simulation iteration.
+     *
+     * Each level has a single writer (the simulator for inputs, the controller for outputs), so atomic levels
+     * are enough and neither side ever waits for the other. A controller polling a line in a tight loop then
+     * doesn't slow down the simulation.
+     *
+     * The controller marks the outputs it writes in a bit mask, so only those are copied back.
      */
-    std::mutex m_voltageLinesMutex;
-    void transferVoltageLevels();
-    float m_microcontrollerVoltageLineLevels[VoltageLine::Idx::Count] = {0};
+    void transferInputLevels();
+    void transferOutputLevels();
+    std::atomic<float> m_microcontrollerVoltageLineLevels[VoltageLine::Idx::Count] = {};
+    std::atomic<uint32_t> m_dirtyVoltageLines = 0;
 
     /**
      * To make the sleep behaviour of the controller consistent with the physics, we should
@@ -129,12 +185,23 @@ private:
      * compared to using the OS sleep function, because the OS sleep function has no guarantee for how
      * long it takes for a sleeping thread to wake up. This also enables us to consistently slow down and
      * speed up the simulation.
+     *
+     * The controller sleeps until an absolute simulated time rather than counting down
+     * steps, so the sleep lasts the same when the step time changes meanwhile (see
+     * StepTimer::OverloadPolicy), and the simulation only compares two times per step
+     * while the controller sleeps.
      */
     std::condition_variable m_conditionWake;
-    unsigned int m_sleepSteps = 0;
-    unsigned int m_stepsTaken = 0;
+    /** Lockstep mode, signaled when the controller sleeps again or main returns */
+    std::condition_variable m_conditionSleep;
+    /** Lockstep mode, true while the controller runs and the simulation waits */
+    bool m_lockstepTurn = false;
+    std::atomic<double> m_wakeTime = 0.0;
+    std::atomic<double> m_elapsedSeconds = 0.0;
     std::mutex m_mutexSteps;
-    float m_currentStepTime = 0.0f;
+    std::atomic<float> m_currentStepTime = 0.0f;
+    /** When the controller last woke up, for tracing (only used by the controller thread) */
+    int64_t m_runStartTime = 0;
 };
 #endif /* __cplusplus */
 
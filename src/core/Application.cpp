@@ -6,6 +6,7 @@
 #include "Event.h"
 #include "Camera.h"
 #include "SceneMenu.h"
+#include "Tracer.h"
 
 /* Glad must be included before any OpenGL stuff */
 #define GLFW_INCLUDE_NONE
@@ -13,10 +14,14 @@
 #include <GLFW/glfw3.h>
 #include <cassert>
 #include <iostream>
+#include <thread>
 
 namespace {
     const glm::vec4 defaultBgColor(0.3f, 0.3f, 0.3f, 1.0f);
     const unsigned int sampleCount = 10;
+    /* Max wall-clock time the simulation thread holds the scene lock when stepping as fast as possible */
+    const float simulationFrameBudget = 0.005f;
+    const float simulationIdleSleepTime = 0.001f;
     const int defaultWidth = 1280;
     const int defaultHeight = 960;
 }
@@ -142,6 +147,7 @@ Application::~Application()
 
 void Application::onKeyCallback(const Event::Key &keyEvent)
 {
+    const auto lock = lockScene();
     if (m_currentScene) {
         m_currentScene->onKeyEvent(keyEvent);
     }
@@ -157,19 +163,31 @@ void Application::onFixedUpdate()
 {
 }
 
-void Application::updatePhysics(float stepTime)
+void Application::setSimulationThreaded(bool threaded)
 {
-    if (m_currentScene) {
-        m_currentScene->updatePhysics(stepTime);
-    }
+    assert(!m_simulationRunning);
+    m_simulationThreaded = threaded;
+}
+
+/**
+ * Locks the scene from the main thread. The simulation thread backs off while the main
+ * thread waits, so it can't starve the main thread by relocking right away.
+ */
+std::unique_lock<std::mutex> Application::lockScene()
+{
+    Tracer::ScopedSpan span("Wait for scene lock");
+    m_renderWaiting = true;
+    std::unique_lock<std::mutex> lock(m_sceneMutex);
+    m_renderWaiting = false;
+    return lock;
 }
 
-void Application::updateLogic(float stepTime)
+void Application::step(float stepTime)
 {
     if (m_currentScene) {
-        m_currentScene->onFixedUpdate();
-        m_currentScene->updateControllers(stepTime);
-        m_currentScene->sceneObjectsOnFixedUpdate();
+        m_currentScene->storePreviousRenderState();
+        m_currentScene->step(stepTime);
+        onFixedUpdate();
     }
 }
 
@@ -181,11 +199,16 @@ void Application::updateLogic(float stepTime)
 bool Application::isStepTimeTooSmall() const
 {
     /* Let average stabilize after a new scene */
-    if (m_currentScene == nullptr && (m_currentScene->getSecondsSinceStart() < 2)) {
+    if (m_currentScene == nullptr || (m_currentScene->getSecondsSinceStart() < 2)) {
+        return false;
+    }
+
+    /* There is no expected step rate when stepping as fast as possible */
+    if (m_sceneMenu->isAsFastAsPossible()) {
         return false;
     }
 
-    const float expectedAvgPhysicsSteps = 1.0f / m_currentScene->getPhysicsStepTime();
+    const float expectedAvgPhysicsSteps = m_sceneMenu->getTimeScale() / m_currentScene->getPhysicsStepTime();
     const float maxGap = 50.0f;
     return expectedAvgPhysicsSteps - m_avgPhysicsSteps > maxGap;
 }
@@ -199,10 +222,14 @@ void Application::updateAndRenderSceneMenu()
         if (lastUpdateSeconds != secondsNow) {
             m_sceneMenu->setFps(m_fps);
             m_sceneMenu->setAvgPhysicsSteps(m_avgPhysicsSteps);
-            if (isStepTimeTooSmall()) {
+            m_sceneMenu->setRealTimeFactor(m_realTimeFactor);
+            /* Safe to read, the scene is locked */
+            const StepTimer::OverloadStats &overloadStats = m_stepTimer.getOverloadStats();
+            m_sceneMenu->setOverloadStats(overloadStats);
+            if (overloadStats.stepMultiplier > 1) {
+                m_sceneMenu->setWarningMessage("Overloaded, stepping coarser!");
+            } else if (isStepTimeTooSmall()) {
                 m_sceneMenu->setWarningMessage("Physics step time too small!");
-            } else if ((1 / m_currentScene->getPhysicsStepTime()) < 2 * m_fps) {
-                m_sceneMenu->setWarningMessage("Reduce physics step time to avoid jittery rendering");
             } else {
                 m_sceneMenu->setWarningMessage("None");
             }
@@ -211,6 +238,8 @@ void Application::updateAndRenderSceneMenu()
     } else if (m_currentScene && m_currentScene->getSecondsSinceStart() == 0) {
         m_sceneMenu->setFps(0);
         m_sceneMenu->setAvgPhysicsSteps(0);
+        m_sceneMenu->setRealTimeFactor(0);
+        m_sceneMenu->setOverloadStats({});
         m_sceneMenu->setWarningMessage("None");
     }
     m_sceneMenu->render();
@@ -218,75 +247,163 @@ void Application::updateAndRenderSceneMenu()
 
 void Application::render()
 {
+    Tracer::ScopedSpan span("Render");
     Renderer::clear(defaultBgColor);
     ImGuiOverlay::newFrame();
+    {
+        const auto lock = lockScene();
+        if (m_currentScene) {
+            m_currentScene->renderMenus();
+        }
+        updateAndRenderSceneMenu();
+    }
     if (m_currentScene) {
-        m_currentScene->render();
+        m_currentScene->renderSnapshot();
     }
     m_scalebar->render();
-    updateAndRenderSceneMenu();
     ImGuiOverlay::render();
     glfwSwapBuffers(m_window);
 }
 
+/**
+ * Takes the physics steps that are due according to the step timer and publishes
+ * a render snapshot. Must be called with the scene locked when the simulation is
+ * threaded.
+ *
+ * \return the number of steps taken
+ */
+unsigned int Application::updateSimulation()
+{
+    Tracer::ScopedSpan span("Update simulation");
+    /* The frame time spikes every time we change the scene. Since we use the frame time
+     * to determine how many physics steps we take, it means that the number of physics
+     * steps also spikes. To counter this, detect when the scene changes and skip updating
+     * the physics for a couple of frames. */
+    if (m_currentScene) {
+        const unsigned int elapsedTime = m_currentScene->getMillisecondsSinceStart();
+        bool changedScene = elapsedTime < m_lastElapsedTime || m_lastElapsedTime == 0;
+        m_lastElapsedTime = elapsedTime;
+        if (changedScene) {
+            m_skipPhysicsUpdate = 5;
+        }
+    }
+
+    m_stepTimer.setTimeScale(m_sceneMenu->getTimeScale());
+    if (m_stepTimer.isAsFastAsPossible() != m_sceneMenu->isAsFastAsPossible()) {
+        m_stepTimer.setAsFastAsPossible(m_sceneMenu->isAsFastAsPossible());
+    }
+    if (m_stepTimer.getOverloadPolicy() != m_sceneMenu->getOverloadPolicy()) {
+        m_stepTimer.setOverloadPolicy(m_sceneMenu->getOverloadPolicy());
+    }
+
+    unsigned int stepsTaken = 0;
+    if (m_currentScene != nullptr && !m_skipPhysicsUpdate) {
+        const float stepTime = m_currentScene->getPhysicsStepTime();
+        stepsTaken = m_stepTimer.advance(stepTime, [this](float currentStepTime) {
+            step(currentStepTime);
+        });
+        const float frameTime = m_stepTimer.getFrameTime();
+        if (frameTime > 0.0f) {
+            const float avgPhysicsSteps = m_avgPhysicsSteps;
+            m_avgPhysicsSteps = avgPhysicsSteps + ((stepsTaken / frameTime) - avgPhysicsSteps) / sampleCount;
+        }
+        m_realTimeFactor = m_stepTimer.getRealTimeFactor();
+        if (stepsTaken > 0) {
+            const float alphaPerSecond = m_stepTimer.isAsFastAsPossible() ? 0.0f : m_stepTimer.getTimeScale() / stepTime;
+            m_currentScene->storeSnapshot(m_stepTimer.getAlpha(stepTime), alphaPerSecond);
+        }
+    } else {
+        m_stepTimer.reset();
+    }
+    if (m_skipPhysicsUpdate > 0) {
+        m_skipPhysicsUpdate--;
+    }
+    return stepsTaken;
+}
+
+/**
+ * The simulation thread loop. Steps the scene (which publishes a render snapshot)
+ * and sleeps until the next step is due.
+ */
+void Application::runSimulation()
+{
+    Tracer::setThreadName("Simulation");
+    m_stepTimer.setFrameBudget(simulationFrameBudget);
+    while (m_simulationRunning) {
+        if (m_renderWaiting) {
+            Tracer::ScopedSpan span("Back off for render");
+            while (m_renderWaiting) {
+                std::this_thread::yield();
+            }
+        }
+        float sleepTime = simulationIdleSleepTime;
+        {
+            std::unique_lock<std::mutex> lock(m_sceneMutex, std::defer_lock);
+            {
+                Tracer::ScopedSpan span("Wait for scene lock");
+                lock.lock();
+            }
+            updateSimulation();
+            if (m_currentScene) {
+                sleepTime = m_stepTimer.getTimeUntilNextStep(m_currentScene->getPhysicsStepTime());
+            }
+        }
+        if (sleepTime > 0.0f) {
+            Tracer::ScopedSpan span("Sleep");
+            std::this_thread::sleep_for(std::chrono::duration<float>(sleepTime));
+        }
+    }
+}
+
 /**
  * The simulator main loop. The physics/logic has a separate update rate from the
  * rendering. The physics/logic is determined by the physics step time (set inside
  * scene) while rendering is capped by VSync. Physics is updated by a fixed step
- * time as per the general recommendation. The technique used here is inspired by
- * the well-known blog post: https://gafferongames.com/post/fix_your_timestep/
+ * time as per the general recommendation, see StepTimer.
+ *
+ * The time scale and "as fast as possible" setting in the scene menu decide how
+ * simulated time relates to wall-clock time. Rendering stays at the display rate
+ * either way.
+ *
+ * When the simulation is threaded (default), the stepping happens in runSimulation()
+ * and this loop only handles events and renders the latest published snapshot.
  *
- * We do no interpolation for the rendering here, so the rendering will be jittery
- * if the physics update rate is close to the rendering rate. Make the physics update
- * rate at least twice as large to avoid this.
+ * The rendering interpolates between the state before and after the latest step,
+ * using how far the accumulated time has come towards the next step. This keeps the
+ * movement smooth even when the physics update rate is lower than the rendering rate.
  */
 void Application::run()
 {
+    Tracer::setThreadName("Main");
+    m_skipPhysicsUpdate = 5;
+    m_lastElapsedTime = 0;
+    m_stepTimer.reset();
+
+    std::thread simulationThread;
+    if (m_simulationThreaded) {
+        m_simulationRunning = true;
+        simulationThread = std::thread(&Application::runSimulation, this);
+    }
+
     double currentTime = glfwGetTime();
-    double accumulator = 0.0;
-    unsigned int stepsTaken = 0;
-    unsigned int skipPhysicsUpdate = 5;
-    unsigned int elapsedTime = 0;
-    unsigned int lastElapsedTime = 0;
     while (!glfwWindowShouldClose(m_window))
     {
-        double newTime = glfwGetTime();
-        double frameTime = newTime - currentTime;
-        if (stepsTaken > 0) {
-            m_fps = 1.0f / frameTime;
-            m_avgPhysicsSteps = m_avgPhysicsSteps + ((stepsTaken / frameTime) - m_avgPhysicsSteps) / sampleCount;
-        }
+        const double newTime = glfwGetTime();
+        const double frameTime = newTime - currentTime;
         currentTime = newTime;
-
-        /* The frame time spikes every time we change the scene. Since we use the frame time
-         * to determine how many physics steps we take, it means that the number of physics
-         * steps also spikes. To counter this, detect when the scene changes and skip updating
-         * the physics for a couple of frames. */
-        if (m_currentScene) {
-            elapsedTime = m_currentScene->getMillisecondsSinceStart();
-            bool changedScene = elapsedTime < lastElapsedTime || lastElapsedTime == 0;
-            lastElapsedTime = elapsedTime;
-            if (changedScene) {
-                skipPhysicsUpdate = 5;
-                accumulator = 0;
-            }
+        if (frameTime > 0.0) {
+            m_fps = 1.0f / frameTime;
         }
 
-        stepsTaken = 0;
-        if (m_currentScene != nullptr && !skipPhysicsUpdate) {
-            while (accumulator >= m_currentScene->getPhysicsStepTime())
-            {
-                stepsTaken++;
-                updatePhysics(m_currentScene->getPhysicsStepTime());
-                updateLogic(m_currentScene->getPhysicsStepTime());
-                accumulator -= m_currentScene->getPhysicsStepTime();
-            }
-            accumulator += frameTime;
-        }
-        if (skipPhysicsUpdate > 0) {
-            skipPhysicsUpdate--;
+        if (!m_simulationThreaded) {
+            updateSimulation();
         }
         glfwPollEvents();
         render();
     }
+
+    if (m_simulationThreaded) {
+        m_simulationRunning = false;
+        simulationThread.join();
+    }
 }
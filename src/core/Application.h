@@ -4,8 +4,11 @@
 #include "Event.h"
 #include <string>
 #include <memory>
+#include <mutex>
+#include <atomic>
 
 #include "Scalebar.h"
+#include "StepTimer.h"
 
 class Scene;
 class SceneMenu;
@@ -15,6 +18,12 @@ struct GLFWwindow;
  * Application base class. Sets up OpenGL and GLFW (window and event handling),
  * and implements the main loop.
  *
+ * By default, the physics and logic are stepped on a separate simulation thread,
+ * while the main thread handles events and rendering. The simulation thread publishes
+ * snapshots of the render state after stepping, which the main thread renders without
+ * locking, so each side runs at its own rate. Menus and key events still lock the
+ * scene, because they modify it.
+ *
  * You inherit this when you create your own Application, look at SimulatorTestApp for
  * an example.
  */
@@ -28,8 +37,13 @@ public:
     void onKeyCallback(const Event::Key &keyEvent);
     virtual void onKeyEvent(const Event::Key &keyEvent);
 
-    /** Runs after every physics step */
+    /** Runs after every physics step (on the simulation thread if it's enabled) */
     virtual void onFixedUpdate();
+    /**
+     * Step the simulation on a separate thread (default) or on the main thread
+     * between frames. Must be called before run().
+     */
+    void setSimulationThreaded(bool threaded);
 
 protected:
     std::unique_ptr<SceneMenu> m_sceneMenu;
@@ -37,15 +51,25 @@ protected:
 
 private:
     bool isStepTimeTooSmall() const;
-    void updatePhysics(float stepTime);
-    void updateLogic(float stepTime);
+    void step(float stepTime);
+    unsigned int updateSimulation();
+    void runSimulation();
+    std::unique_lock<std::mutex> lockScene();
     void updateAndRenderSceneMenu();
     void render();
 
     GLFWwindow *m_window = nullptr;
     std::unique_ptr<Scalebar> m_scalebar = nullptr;
+    StepTimer m_stepTimer;
     float m_fps = 0.0f;
-    float m_avgPhysicsSteps = 0.0f;
+    std::atomic<float> m_avgPhysicsSteps = 0.0f;
+    std::atomic<float> m_realTimeFactor = 0.0f;
+    unsigned int m_skipPhysicsUpdate = 5;
+    unsigned int m_lastElapsedTime = 0;
+    bool m_simulationThreaded = true;
+    std::atomic<bool> m_simulationRunning = false;
+    std::atomic<bool> m_renderWaiting = false;
+    std::mutex m_sceneMutex;
     Scene *m_currentScene = nullptr;
 };
 
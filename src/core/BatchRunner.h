@@ -0,0 +1,85 @@
+#ifndef BATCH_RUNNER_H_
+#define BATCH_RUNNER_H_
+
+#include "HeadlessRunner.h"
+#include "ThreadPool.h"
+#include "Scene.h"
+
+#include <vector>
+#include <functional>
+#include <cassert>
+
+/**
+ * Runs many independent instances of a scene in parallel (headless), e.g. hundreds of
+ * sumobot matches. Each instance is created from a factory, stepped by a HeadlessRunner
+ * on a thread pool and reduced to a result when done.
+ *
+ * This works because a Scene owns its PhysicsWorld, and nothing in the core (unlike the
+ * renderer and Camera) is global. Some things are still shared though:
+ * - C microcontrollers created with the main function without userdata share a static
+ *   userdata pointer, so only one such controller can exist at a time. Use the
+ *   userdata variant in scenes that are run in a batch.
+ * - A Microcontroller in thread execution mode runs on its own OS thread, which is an
+ *   overhead when running many instances, and its timing relative to the steps varies
+ *   from run to run. Use the coroutine (or lockstep) execution mode instead, the
+ *   results are then the same every run.
+ *
+ * Scenes can trade accuracy for throughput by enabling the benchmark physics settings
+ * from the factory (see PhysicsWorld::setBenchmarkEnabled).
+ *
+ * Example:
+ *   BatchRunner batchRunner;
+ *   batchRunner.registerScene<MatchScene>();
+ *   auto winners = batchRunner.run<int>(100, 180.0f, [](Scene &scene, unsigned int index) {
+ *       return static_cast<MatchScene &>(scene).getWinner();
+ *   });
+ */
+class BatchRunner
+{
+public:
+    /** \param threadCount Number of threads to use, zero means one per core */
+    BatchRunner(unsigned int threadCount = 0) :
+        m_threadPool(threadCount)
+    {
+    }
+
+    template<typename T>
+    void registerScene()
+    {
+        m_sceneFactory = [](unsigned int) { return new T(); };
+    }
+    /** The factory gets the instance index, e.g. to vary parameters or seeds */
+    void registerSceneFactory(std::function<Scene*(unsigned int)> sceneFactory)
+    {
+        m_sceneFactory = sceneFactory;
+    }
+    unsigned int getThreadCount() const { return m_threadPool.getThreadCount(); }
+
+    /**
+     * Creates sceneCount scenes, runs each for simulatedSeconds (or until the scene
+     * stops the runner) and collects a result from each. Blocks until all are done.
+     *
+     * \param collectResult Called from a worker thread when a scene is done, right before
+     * the scene is destroyed.
+     * \return The results indexed by scene index
+     */
+    template<typename Result>
+    std::vector<Result> run(unsigned int sceneCount, float simulatedSeconds,
+                            std::function<Result(Scene &, unsigned int)> collectResult)
+    {
+        assert(m_sceneFactory);
+        std::vector<Result> results(sceneCount);
+        m_threadPool.parallelFor(sceneCount, [&](unsigned int index) {
+            HeadlessRunner runner(m_sceneFactory(index));
+            runner.run(simulatedSeconds);
+            results[index] = collectResult(*runner.getScene(), index);
+        });
+        return results;
+    }
+
+private:
+    ThreadPool m_threadPool;
+    std::function<Scene*(unsigned int)> m_sceneFactory;
+};
+
+#endif /* BATCH_RUNNER_H_ */
@@ -0,0 +1,209 @@
+#include "Fiber.h"
+
+#include <cassert>
+#include <cstdint>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#if defined(__x86_64__)
+#define FIBER_X86_64_SWITCH
+#else
+#include <ucontext.h>
+#endif
+#endif
+
+namespace {
+    /* The fiber currently running on this thread */
+    thread_local Fiber *t_currentFiber = nullptr;
+
+#if !defined(_WIN32)
+    /**
+     * Stack memory mapped straight from the OS, so pages are only committed when the
+     * fiber touches them, with an inaccessible guard page below it (stacks grow down).
+     * Windows fibers get the same from CreateFiber.
+     */
+    struct FiberStack
+    {
+        FiberStack(size_t size)
+        {
+            const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            this->size = (size + pageSize - 1) / pageSize * pageSize;
+            mappingSize = this->size + pageSize;
+            void *mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+            assert(mapping != MAP_FAILED);
+            base = static_cast<unsigned char *>(mapping);
+            const int result = mprotect(base, pageSize, PROT_NONE);
+            assert(result == 0);
+            (void)result;
+            bottom = base + pageSize;
+        }
+        ~FiberStack()
+        {
+            munmap(base, mappingSize);
+        }
+        FiberStack(const FiberStack &) = delete;
+        FiberStack &operator=(const FiberStack &) = delete;
+
+        unsigned char *base = nullptr;
+        size_t mappingSize = 0;
+        /** Lowest usable address */
+        unsigned char *bottom = nullptr;
+        size_t size = 0;
+    };
+#endif
+}
+
+#if defined(FIBER_X86_64_SWITCH)
+/*
+ * Saves the callee-saved registers (System V ABI) and the floating-point control
+ * words on the current stack, stores the stack pointer in *saveStackPointer and
+ * restores the same from loadStackPointer. The final ret continues where the other
+ * side last switched (or at Fiber::entry the first time).
+ */
+extern "C" void bots2d_switch_stack(void **saveStackPointer, void *loadStackPointer);
+__asm__(
+    ".text\n"
+    ".globl bots2d_switch_stack\n"
+    ".type bots2d_switch_stack,@function\n"
+    "bots2d_switch_stack:\n"
+    "    pushq %rbp\n"
+    "    pushq %rbx\n"
+    "    pushq %r12\n"
+    "    pushq %r13\n"
+    "    pushq %r14\n"
+    "    pushq %r15\n"
+    "    subq $8, %rsp\n"
+    "    stmxcsr (%rsp)\n"
+    "    fnstcw 4(%rsp)\n"
+    "    movq %rsp, (%rdi)\n"
+    "    movq %rsi, %rsp\n"
+    "    ldmxcsr (%rsp)\n"
+    "    fldcw 4(%rsp)\n"
+    "    addq $8, %rsp\n"
+    "    popq %r15\n"
+    "    popq %r14\n"
+    "    popq %r13\n"
+    "    popq %r12\n"
+    "    popq %rbx\n"
+    "    popq %rbp\n"
+    "    ret\n"
+    ".size bots2d_switch_stack,.-bots2d_switch_stack\n"
+);
+
+struct Fiber::Context
+{
+    Context(size_t stackSize) : stack(stackSize) {}
+    FiberStack stack;
+    void *stackPointer = nullptr;
+    void *callerStackPointer = nullptr;
+};
+#elif defined(_WIN32)
+struct Fiber::Context
+{
+    Context(size_t) {}
+    LPVOID fiber = nullptr;
+    LPVOID callerFiber = nullptr;
+};
+#else
+struct Fiber::Context
+{
+    Context(size_t stackSize) : stack(stackSize) {}
+    FiberStack stack;
+    ucontext_t context;
+    ucontext_t callerContext;
+};
+#endif
+
+Fiber::Fiber(std::function<void()> function, size_t stackSize) :
+    m_function(function),
+    m_context(std::make_unique<Context>(stackSize))
+{
+    assert(m_function);
+#if defined(FIBER_X86_64_SWITCH)
+    /* Lay out the stack as if bots2d_switch_stack had been called from entry, so the
+     * first switch "returns" into it. The zero below entry is a return address that
+     * is never used, but keeps the stack aligned as at a regular function call. */
+    uintptr_t top = reinterpret_cast<uintptr_t>(m_context->stack.bottom + m_context->stack.size) & ~static_cast<uintptr_t>(15);
+    uint64_t *stack = reinterpret_cast<uint64_t *>(top);
+    *--stack = 0;
+    *--stack = reinterpret_cast<uint64_t>(&Fiber::entry);
+    for (int i = 0; i < 6; i++) {
+        /* rbp, rbx, r12-r15 */
+        *--stack = 0;
+    }
+    /* Default MXCSR and x87 control word */
+    *--stack = (static_cast<uint64_t>(0x037F) << 32) | 0x1F80;
+    m_context->stackPointer = stack;
+#elif defined(_WIN32)
+    m_context->fiber = CreateFiber(stackSize, [](LPVOID) { Fiber::entry(); }, nullptr);
+    assert(m_context->fiber != nullptr);
+#else
+    getcontext(&m_context->context);
+    m_context->context.uc_stack.ss_sp = m_context->stack.bottom;
+    m_context->context.uc_stack.ss_size = m_context->stack.size;
+    m_context->context.uc_link = nullptr;
+    makecontext(&m_context->context, &Fiber::entry, 0);
+#endif
+}
+
+Fiber::~Fiber()
+{
+    assert(t_currentFiber != this);
+#if defined(_WIN32)
+    DeleteFiber(m_context->fiber);
+#endif
+}
+
+void Fiber::resume()
+{
+    assert(!m_finished);
+    /* Fibers can be resumed from inside other fibers */
+    Fiber *resumingFiber = t_currentFiber;
+    t_currentFiber = this;
+#if defined(FIBER_X86_64_SWITCH)
+    bots2d_switch_stack(&m_context->callerStackPointer, m_context->stackPointer);
+#elif defined(_WIN32)
+    if (!IsThreadAFiber()) {
+        ConvertThreadToFiber(nullptr);
+    }
+    m_context->callerFiber = GetCurrentFiber();
+    SwitchToFiber(m_context->fiber);
+#else
+    swapcontext(&m_context->callerContext, &m_context->context);
+#endif
+    t_currentFiber = resumingFiber;
+}
+
+void Fiber::yield()
+{
+    Fiber *fiber = t_currentFiber;
+    assert(fiber != nullptr);
+#if defined(FIBER_X86_64_SWITCH)
+    bots2d_switch_stack(&fiber->m_context->stackPointer, fiber->m_context->callerStackPointer);
+#elif defined(_WIN32)
+    SwitchToFiber(fiber->m_context->callerFiber);
+#else
+    swapcontext(&fiber->m_context->context, &fiber->m_context->callerContext);
+#endif
+}
+
+bool Fiber::isInsideFiber()
+{
+    return t_currentFiber != nullptr;
+}
+
+/**
+ * First function on the fiber's stack. It must never return, because there is
+ * nothing to return to, so it yields for good when the function is done.
+ */
+void Fiber::entry()
+{
+    Fiber *fiber = t_currentFiber;
+    fiber->m_function();
+    fiber->m_finished = true;
+    yield();
+    assert(false);
+}
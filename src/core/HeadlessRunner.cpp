@@ -0,0 +1,64 @@
+#include "HeadlessRunner.h"
+#include "Scene.h"
+
+#include <chrono>
+#include <cassert>
+
+HeadlessRunner::HeadlessRunner(Scene *scene) :
+    m_scene(scene)
+{
+    assert(m_scene != nullptr);
+}
+
+HeadlessRunner::~HeadlessRunner()
+{
+    delete m_scene;
+}
+
+void HeadlessRunner::onFixedUpdate()
+{
+}
+
+void HeadlessRunner::stop()
+{
+    m_stopped = true;
+}
+
+unsigned int HeadlessRunner::getStepsTaken() const
+{
+    return m_scene->getStepCount();
+}
+
+double HeadlessRunner::getSimulatedSeconds() const
+{
+    return m_scene->getSimulatedSeconds();
+}
+
+void HeadlessRunner::step()
+{
+    m_scene->step(m_scene->getPhysicsStepTime());
+    onFixedUpdate();
+}
+
+void HeadlessRunner::run(float simulatedSeconds)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    const double endSeconds = m_scene->getSimulatedSeconds() + simulatedSeconds;
+    /* Stop half a step early to not overshoot because of rounding */
+    const double margin = 0.5 * m_scene->getPhysicsStepTime();
+    m_stopped = false;
+    while (!m_stopped && m_scene->getSimulatedSeconds() + margin < endSeconds) {
+        step();
+    }
+    m_elapsedSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+void HeadlessRunner::runSteps(unsigned int stepCount)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    m_stopped = false;
+    for (unsigned int i = 0; i < stepCount && !m_stopped; i++) {
+        step();
+    }
+    m_elapsedSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+}
@@ -0,0 +1,46 @@
+#ifndef HEADLESS_RUNNER_H_
+#define HEADLESS_RUNNER_H_
+
+class Scene;
+
+/**
+ * Runs a Scene without a window or OpenGL context. It steps the physics and logic
+ * back-to-back with the scene's physics step time (no rendering, no vsync and no
+ * wall-clock accumulator), so the simulation runs as fast as the host allows.
+ *
+ * Useful on machines without a display (e.g. build servers) or when you want the
+ * result of a long simulation (e.g. a 3-minute sumo match) in a couple of seconds.
+ * Renderable components are still created but never drawn, and textures are never
+ * uploaded.
+ */
+class HeadlessRunner
+{
+public:
+    /** Takes ownership of the scene */
+    HeadlessRunner(Scene *scene);
+    virtual ~HeadlessRunner();
+    /** Runs until the given amount of simulated time has passed or stop() is called */
+    void run(float simulatedSeconds);
+    /** Runs the given number of fixed steps or until stop() is called */
+    void runSteps(unsigned int stepCount);
+    /** Stops run()/runSteps() after the current step, e.g. from onFixedUpdate() */
+    void stop();
+
+    /** Runs after every physics step */
+    virtual void onFixedUpdate();
+
+    Scene *getScene() const { return m_scene; }
+    unsigned int getStepsTaken() const;
+    double getSimulatedSeconds() const;
+    /** Wall-clock seconds spent inside run()/runSteps() */
+    double getElapsedSeconds() const { return m_elapsedSeconds; }
+
+private:
+    void step();
+
+    Scene *m_scene = nullptr;
+    double m_elapsedSeconds = 0.0;
+    bool m_stopped = false;
+};
+
+#endif /* HEADLESS_RUNNER_H_ */
@@ -0,0 +1,136 @@
+#include "Profiler.h"
+
+#include <array>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <fstream>
+#include <cassert>
+
+namespace {
+/* At 1 kHz step rate this is the latest second of steps */
+const unsigned int windowSize = 1000;
+const unsigned int phaseCount = static_cast<unsigned int>(Profiler::Phase::Count);
+
+struct PhaseSamples {
+    std::mutex mutex;
+    std::array<float, windowSize> samples;
+    unsigned int count = 0;
+    unsigned int next = 0;
+};
+
+std::array<PhaseSamples, phaseCount> s_phaseSamples;
+std::atomic<bool> s_enabled = false;
+
+PhaseSamples &getPhaseSamples(Profiler::Phase phase)
+{
+    assert(phase != Profiler::Phase::Count);
+    return s_phaseSamples[static_cast<unsigned int>(phase)];
+}
+
+float percentile(std::vector<float> &samples, float fraction)
+{
+    const auto nth = samples.begin() + static_cast<size_t>(fraction * (samples.size() - 1));
+    std::nth_element(samples.begin(), nth, samples.end());
+    return *nth;
+}
+}
+
+Profiler::ScopedTimer::ScopedTimer(Phase phase) :
+    m_phase(phase),
+    m_enabled(Profiler::isEnabled())
+{
+    if (m_enabled) {
+        m_startTime = std::chrono::steady_clock::now();
+    }
+}
+
+Profiler::ScopedTimer::~ScopedTimer()
+{
+    if (m_enabled) {
+        const auto duration = std::chrono::steady_clock::now() - m_startTime;
+        Profiler::record(m_phase, std::chrono::duration<float, std::micro>(duration).count());
+    }
+}
+
+void Profiler::setEnabled(bool enabled)
+{
+    s_enabled = enabled;
+}
+
+bool Profiler::isEnabled()
+{
+    return s_enabled.load(std::memory_order_relaxed);
+}
+
+void Profiler::record(Phase phase, float microseconds)
+{
+    PhaseSamples &phaseSamples = getPhaseSamples(phase);
+    std::lock_guard<std::mutex> lock(phaseSamples.mutex);
+    phaseSamples.samples[phaseSamples.next] = microseconds;
+    phaseSamples.next = (phaseSamples.next + 1) % windowSize;
+    if (phaseSamples.count < windowSize) {
+        phaseSamples.count++;
+    }
+}
+
+Profiler::PhaseStats Profiler::getStats(Phase phase)
+{
+    PhaseSamples &phaseSamples = getPhaseSamples(phase);
+    std::vector<float> samples;
+    {
+        std::lock_guard<std::mutex> lock(phaseSamples.mutex);
+        samples.assign(phaseSamples.samples.begin(), phaseSamples.samples.begin() + phaseSamples.count);
+    }
+
+    PhaseStats stats;
+    if (samples.empty()) {
+        return stats;
+    }
+    stats.sampleCount = static_cast<unsigned int>(samples.size());
+    stats.max = *std::max_element(samples.begin(), samples.end());
+    stats.p99 = percentile(samples, 0.99f);
+    stats.p50 = percentile(samples, 0.5f);
+    return stats;
+}
+
+std::string Profiler::getPhaseName(Phase phase)
+{
+    switch (phase) {
+    case Phase::PhysicsWorldStep: return "PhysicsWorld::step";
+    case Phase::UpdatePhysics: return "SceneObject::updatePhysics";
+    case Phase::UpdateControllers: return "Controllers";
+    case Phase::SceneObjectsOnFixedUpdate: return "SceneObject::onFixedUpdate";
+    case Phase::SceneRender: return "Scene::render";
+    case Phase::ImGuiOverlayRender: return "ImGuiOverlay::render";
+    case Phase::Count: break;
+    }
+    assert(false);
+    return "";
+}
+
+void Profiler::reset()
+{
+    for (auto &phaseSamples : s_phaseSamples) {
+        std::lock_guard<std::mutex> lock(phaseSamples.mutex);
+        phaseSamples.count = 0;
+        phaseSamples.next = 0;
+    }
+}
+
+bool Profiler::exportCsv(const std::string &filename)
+{
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+    file << "phase,samples,p50_us,p99_us,max_us\n";
+    for (unsigned int i = 0; i < phaseCount; i++) {
+        const Phase phase = static_cast<Phase>(i);
+        const PhaseStats stats = getStats(phase);
+        file << getPhaseName(phase) << "," << stats.sampleCount << "," << stats.p50 << ","
+             << stats.p99 << "," << stats.max << "\n";
+    }
+    return file.good();
+}
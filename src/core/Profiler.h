@@ -0,0 +1,65 @@
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+#include <string>
+#include <chrono>
+
+/**
+ * Measures how long the phases of a frame take, to see which subsystem is the
+ * bottleneck (e.g. when a scene with many bots slows down).
+ *
+ * The phases are timed with ScopedTimer. The latest samples of each phase are kept
+ * in a rolling window, from which the percentiles are calculated. Profiling is
+ * disabled by default, in which case a ScopedTimer costs a single atomic load.
+ *
+ * Samples can be recorded from any thread (the simulation thread records the step
+ * phases and the main thread the render phases).
+ */
+class Profiler
+{
+public:
+    enum class Phase {
+        PhysicsWorldStep,
+        UpdatePhysics,
+        UpdateControllers,
+        SceneObjectsOnFixedUpdate,
+        SceneRender,
+        ImGuiOverlayRender,
+        Count
+    };
+
+    /** Durations in microseconds over the rolling window */
+    struct PhaseStats {
+        unsigned int sampleCount = 0;
+        float p50 = 0.0f;
+        float p99 = 0.0f;
+        float max = 0.0f;
+    };
+
+    /** Records the time from construction to destruction as a sample of the given phase */
+    class ScopedTimer
+    {
+    public:
+        ScopedTimer(Phase phase);
+        ~ScopedTimer();
+    private:
+        const Phase m_phase;
+        const bool m_enabled;
+        std::chrono::steady_clock::time_point m_startTime;
+    };
+
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+    static void record(Phase phase, float microseconds);
+    static PhaseStats getStats(Phase phase);
+    static std::string getPhaseName(Phase phase);
+    /** Clears the samples of all phases */
+    static void reset();
+    /**
+     * Writes the stats of all phases to a CSV file (one row per phase).
+     * \return false if the file couldn't be opened
+     */
+    static bool exportCsv(const std::string &filename);
+};
+
+#endif /* PROFILER_H_ */
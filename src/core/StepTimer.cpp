@@ -0,0 +1,157 @@
+#include "StepTimer.h"
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+
+namespace {
+    const unsigned int sampleCount = 10;
+}
+
+StepTimer::StepTimer() :
+    m_lastTime(Clock::now())
+{
+}
+
+void StepTimer::setTimeScale(float timeScale)
+{
+    assert(timeScale > 0.0f);
+    m_timeScale = timeScale;
+}
+
+void StepTimer::setAsFastAsPossible(bool enabled)
+{
+    m_asFastAsPossible = enabled;
+    m_accumulator = 0.0;
+}
+
+void StepTimer::setFrameBudget(float seconds)
+{
+    assert(seconds > 0.0f);
+    m_frameBudget = seconds;
+}
+
+void StepTimer::setMaxStepsPerAdvance(unsigned int maxSteps)
+{
+    m_maxStepsPerAdvance = maxSteps;
+}
+
+void StepTimer::setMaxAccumulatedTime(float seconds)
+{
+    assert(seconds > 0.0f);
+    m_maxAccumulatedTime = seconds;
+}
+
+void StepTimer::setOverloadPolicy(OverloadPolicy policy)
+{
+    m_overloadPolicy = policy;
+    m_overloadStats.stepMultiplier = 1;
+}
+
+void StepTimer::setMaxStepMultiplier(unsigned int maxMultiplier)
+{
+    assert(maxMultiplier >= 1);
+    m_maxStepMultiplier = maxMultiplier;
+}
+
+void StepTimer::reset()
+{
+    m_lastTime = Clock::now();
+    m_accumulator = 0.0;
+    m_frameTime = 0.0f;
+    m_realTimeFactor = 0.0f;
+    m_overloadStats = {};
+}
+
+float StepTimer::getTimeUntilNextStep(float stepTime) const
+{
+    stepTime *= m_overloadStats.stepMultiplier;
+    if (m_asFastAsPossible || m_accumulator >= stepTime) {
+        return 0.0f;
+    }
+    const float timeSinceAdvance = std::chrono::duration<float>(Clock::now() - m_lastTime).count();
+    const float timeUntilNextStep = (stepTime - m_accumulator) / m_timeScale - timeSinceAdvance;
+    return timeUntilNextStep > 0.0f ? timeUntilNextStep : 0.0f;
+}
+
+float StepTimer::getAlpha(float stepTime) const
+{
+    if (m_asFastAsPossible) {
+        return 1.0f;
+    }
+    return static_cast<float>(m_accumulator / (stepTime * m_overloadStats.stepMultiplier));
+}
+
+/**
+ * Called when the budget ran out before the accumulator was consumed. Either drops
+ * the remaining time or makes the steps coarser so the next call can catch up.
+ */
+void StepTimer::onOverloaded(float stepTime)
+{
+    m_overloadStats.overloadedFrames++;
+    if (m_overloadPolicy == OverloadPolicy::CoarserStep &&
+        m_overloadStats.stepMultiplier < m_maxStepMultiplier) {
+        m_overloadStats.stepMultiplier = std::min(2 * m_overloadStats.stepMultiplier, m_maxStepMultiplier);
+        return;
+    }
+    /* Keep the fraction of a step, so the interpolation stays smooth */
+    const double keptTime = std::fmod(m_accumulator, static_cast<double>(stepTime));
+    m_overloadStats.droppedSeconds += m_accumulator - keptTime;
+    m_accumulator = keptTime;
+}
+
+unsigned int StepTimer::advance(float stepTime, const std::function<void(float)> &stepFunction)
+{
+    assert(stepTime > 0.0f);
+    const auto timeNow = Clock::now();
+    m_frameTime = std::chrono::duration<float>(timeNow - m_lastTime).count();
+    m_lastTime = timeNow;
+    const auto frameEnd = timeNow + std::chrono::duration<float>(m_frameBudget);
+
+    unsigned int stepsTaken = 0;
+    float simulatedTime = 0.0f;
+    if (m_asFastAsPossible) {
+        do {
+            stepFunction(stepTime);
+            stepsTaken++;
+            simulatedTime += stepTime;
+        } while (Clock::now() < frameEnd &&
+                 (m_maxStepsPerAdvance == 0 || stepsTaken < m_maxStepsPerAdvance));
+    } else {
+        m_accumulator += m_frameTime * m_timeScale;
+        if (m_accumulator > m_maxAccumulatedTime) {
+            m_overloadStats.clampedFrames++;
+            m_overloadStats.droppedSeconds += m_accumulator - m_maxAccumulatedTime;
+            m_accumulator = m_maxAccumulatedTime;
+        }
+
+        const float currentStepTime = stepTime * m_overloadStats.stepMultiplier;
+        bool overloaded = false;
+        while (m_accumulator >= currentStepTime) {
+            if ((m_maxStepsPerAdvance != 0 && stepsTaken >= m_maxStepsPerAdvance) ||
+                (stepsTaken > 0 && Clock::now() >= frameEnd)) {
+                overloaded = true;
+                break;
+            }
+            stepFunction(currentStepTime);
+            stepsTaken++;
+            simulatedTime += currentStepTime;
+            m_accumulator -= currentStepTime;
+        }
+
+        if (overloaded) {
+            onOverloaded(currentStepTime);
+        } else if (m_overloadStats.stepMultiplier > 1) {
+            /* Caught up, go back towards the original step time */
+            m_overloadStats.stepMultiplier /= 2;
+        }
+        if (currentStepTime > stepTime) {
+            m_overloadStats.coarseSteps += stepsTaken;
+        }
+    }
+
+    if (m_frameTime > 0.0f) {
+        const float realTimeFactor = simulatedTime / m_frameTime;
+        m_realTimeFactor = m_realTimeFactor + (realTimeFactor - m_realTimeFactor) / sampleCount;
+    }
+    return stepsTaken;
+}
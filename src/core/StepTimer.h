@@ -0,0 +1,107 @@
+#ifndef STEP_TIMER_H_
+#define STEP_TIMER_H_
+
+#include <chrono>
+#include <functional>
+
+/**
+ * Decides how many fixed steps to take based on elapsed wall-clock time. The
+ * technique is inspired by the well-known blog post:
+ * https://gafferongames.com/post/fix_your_timestep/
+ *
+ * The elapsed wall-clock time is multiplied by the time scale before it's added to
+ * the accumulator, so simulated time can run slower or faster than real time. In
+ * "as fast as possible" mode, steps are taken back-to-back until the frame budget
+ * (wall-clock time) is used up, regardless of the time scale.
+ *
+ * If the steps take longer than the time they simulate, the accumulator grows every
+ * call (the "spiral of death"). To avoid that, stepping stops when the frame budget or
+ * the max number of steps per call is used up, and the accumulator is clamped. What
+ * happens to the time that is left is decided by the overload policy.
+ */
+class StepTimer
+{
+public:
+    enum class OverloadPolicy {
+        /** Drop the time that is left, i.e. simulated time runs slower than requested */
+        SlowDown,
+        /** Take larger steps (multiples of the step time) until it keeps up again */
+        CoarserStep
+    };
+
+    /** Statistics of the overload handling since the last reset() */
+    struct OverloadStats {
+        /** Calls to advance() that ran out of budget */
+        unsigned int overloadedFrames = 0;
+        /** Calls to advance() where the accumulator was clamped */
+        unsigned int clampedFrames = 0;
+        /** Simulated time dropped by slowing down */
+        double droppedSeconds = 0.0;
+        /** Steps taken with a coarser step time */
+        unsigned int coarseSteps = 0;
+        /** Current step time multiplier (1 when not overloaded) */
+        unsigned int stepMultiplier = 1;
+    };
+
+    StepTimer();
+    /** Simulated seconds per wall-clock second (1.0 is real time) */
+    void setTimeScale(float timeScale);
+    float getTimeScale() const { return m_timeScale; }
+    void setAsFastAsPossible(bool enabled);
+    bool isAsFastAsPossible() const { return m_asFastAsPossible; }
+    /** Max wall-clock time to spend stepping per call to advance() */
+    void setFrameBudget(float seconds);
+    /** Max steps per call to advance(), zero means no limit */
+    void setMaxStepsPerAdvance(unsigned int maxSteps);
+    /** Max accumulated (simulated) time, anything above is dropped */
+    void setMaxAccumulatedTime(float seconds);
+    void setOverloadPolicy(OverloadPolicy policy);
+    OverloadPolicy getOverloadPolicy() const { return m_overloadPolicy; }
+    /** Max step time multiplier for OverloadPolicy::CoarserStep */
+    void setMaxStepMultiplier(unsigned int maxMultiplier);
+    const OverloadStats &getOverloadStats() const { return m_overloadStats; }
+
+    /** Drops accumulated time and restarts the clock, e.g. after changing scene */
+    void reset();
+    /**
+     * Calls stepFunction for each fixed step that is due since the last call. The
+     * step time passed to stepFunction is larger than stepTime when stepping coarser.
+     * \return the number of steps taken
+     */
+    unsigned int advance(float stepTime, const std::function<void(float)> &stepFunction);
+
+    /**
+     * Wall-clock time until the next step is due (zero in "as fast as possible" mode).
+     * Useful for sleeping when stepping on a dedicated thread.
+     */
+    float getTimeUntilNextStep(float stepTime) const;
+    /**
+     * How far the accumulated time has come towards the next step (0 to 1), used
+     * for interpolating the rendering. Always 1 in "as fast as possible" mode.
+     */
+    float getAlpha(float stepTime) const;
+    /** Wall-clock time between the two latest calls to advance() */
+    float getFrameTime() const { return m_frameTime; }
+    /** Simulated time per wall-clock time (averaged) */
+    float getRealTimeFactor() const { return m_realTimeFactor; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void onOverloaded(float stepTime);
+
+    float m_timeScale = 1.0f;
+    bool m_asFastAsPossible = false;
+    float m_frameBudget = 1.0f / 60.0f;
+    unsigned int m_maxStepsPerAdvance = 0;
+    float m_maxAccumulatedTime = 0.25f;
+    OverloadPolicy m_overloadPolicy = OverloadPolicy::SlowDown;
+    unsigned int m_maxStepMultiplier = 8;
+    OverloadStats m_overloadStats;
+    Clock::time_point m_lastTime;
+    double m_accumulator = 0.0;
+    float m_frameTime = 0.0f;
+    float m_realTimeFactor = 0.0f;
+};
+
+#endif /* STEP_TIMER_H_ */
@@ -0,0 +1,95 @@
+#include "ThreadPool.h"
+#include <cassert>
+
+ThreadPool::ThreadPool(unsigned int threadCount)
+{
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    if (threadCount == 0) {
+        /* Number of cores unknown */
+        threadCount = 1;
+    }
+    for (unsigned int i = 0; i < threadCount - 1; i++) {
+        m_threads.emplace_back(&ThreadPool::workerThreadFn, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = false;
+    }
+    m_conditionWork.notify_all();
+    for (auto &thread : m_threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::runJobs()
+{
+    unsigned int index = m_nextIndex++;
+    while (index < m_count) {
+        (*m_function)(index);
+        index = m_nextIndex++;
+    }
+}
+
+void ThreadPool::workerThreadFn()
+{
+    unsigned int lastGeneration = 0;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_conditionWork.wait(lock, [this, lastGeneration] {
+            return !m_running || m_generation != lastGeneration;
+        });
+        if (!m_running) {
+            return;
+        }
+        lastGeneration = m_generation;
+        lock.unlock();
+        runJobs();
+        lock.lock();
+        m_busyWorkers--;
+        if (m_busyWorkers == 0) {
+            m_conditionDone.notify_one();
+        }
+    }
+}
+
+void ThreadPool::parallelFor(unsigned int count, const std::function<void(unsigned int)> &function)
+{
+    if (count == 0) {
+        return;
+    }
+    std::unique_lock<std::mutex> callerLock(m_callerMutex, std::defer_lock);
+    if (m_threads.empty() || count == 1 || !callerLock.try_lock()) {
+        for (unsigned int i = 0; i < count; i++) {
+            function(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        assert(m_busyWorkers == 0);
+        m_function = &function;
+        m_count = count;
+        m_nextIndex = 0;
+        m_busyWorkers = static_cast<unsigned int>(m_threads.size());
+        m_generation++;
+    }
+    m_conditionWork.notify_all();
+    runJobs();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_conditionDone.wait(lock, [this] { return m_busyWorkers == 0; });
+    m_function = nullptr;
+}
+
+ThreadPool &ThreadPool::getShared()
+{
+    static ThreadPool sharedThreadPool;
+    return sharedThreadPool;
+}
@@ -0,0 +1,55 @@
+#ifndef THREAD_POOL_H_
+#define THREAD_POOL_H_
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+
+/**
+ * A fixed set of worker threads for running independent jobs in parallel.
+ *
+ * parallelFor hands out the indices one at a time, so jobs of uneven length (e.g.
+ * sumo matches that end early) are balanced across the threads. The calling thread
+ * takes part in the work, so a pool of N threads starts N - 1 worker threads.
+ *
+ * If parallelFor is called while the pool is busy (from another thread or from inside
+ * a job), the jobs are run serially on the calling thread instead. That way a shared
+ * pool can be used from code that itself runs in parallel, e.g. in BatchRunner.
+ */
+class ThreadPool
+{
+public:
+    /** \param threadCount Number of threads to use, zero means one per core */
+    ThreadPool(unsigned int threadCount = 0);
+    ~ThreadPool();
+    unsigned int getThreadCount() const { return static_cast<unsigned int>(m_threads.size()) + 1; }
+    /**
+     * Calls function(index) for every index in [0, count) and returns when all calls
+     * are done.
+     */
+    void parallelFor(unsigned int count, const std::function<void(unsigned int)> &function);
+    /** A pool with one thread per core shared by the whole process, created on first use */
+    static ThreadPool &getShared();
+
+private:
+    void workerThreadFn();
+    void runJobs();
+
+    std::vector<std::thread> m_threads;
+    /** Held by the thread that's currently running a parallelFor */
+    std::mutex m_callerMutex;
+    std::mutex m_mutex;
+    std::condition_variable m_conditionWork;
+    std::condition_variable m_conditionDone;
+    const std::function<void(unsigned int)> *m_function = nullptr;
+    unsigned int m_count = 0;
+    std::atomic<unsigned int> m_nextIndex = 0;
+    unsigned int m_busyWorkers = 0;
+    unsigned int m_generation = 0;
+    bool m_running = true;
+};
+
+#endif /* THREAD_POOL_H_ */
@@ -0,0 +1,158 @@
+#include "Tracer.h"
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <cassert>
+
+namespace {
+/* 24 MB of address space per traced thread, only the used part is touched */
+const unsigned int maxSpansPerThread = 1 << 20;
+
+struct Span {
+    const char *name;
+    int64_t startTime;
+    int64_t endTime;
+};
+
+/**
+ * Only the owning thread writes spans, and it publishes them by incrementing the count
+ * (release), so stop() can read the spans below the count (acquire) without locking.
+ */
+struct ThreadBuffer {
+    ThreadBuffer(unsigned int threadId, const std::string &threadName) :
+        threadId(threadId), threadName(threadName), spans(new Span[maxSpansPerThread]) {}
+    const unsigned int threadId;
+    std::string threadName;
+    const std::unique_ptr<Span[]> spans;
+    std::atomic<unsigned int> count = 0;
+    std::atomic<unsigned int> droppedCount = 0;
+};
+
+std::atomic<bool> s_enabled = false;
+bool s_started = false;
+std::string s_filename;
+int64_t s_startTime = 0;
+/* Only locked when a thread records its first span, and when writing the trace */
+std::mutex s_threadBuffersMutex;
+std::vector<std::unique_ptr<ThreadBuffer>> s_threadBuffers;
+/* The buffers are owned by s_threadBuffers, so they survive the threads that recorded them */
+thread_local ThreadBuffer *t_threadBuffer = nullptr;
+thread_local std::string t_threadName;
+
+ThreadBuffer *getThreadBuffer()
+{
+    if (t_threadBuffer == nullptr) {
+        std::lock_guard<std::mutex> lock(s_threadBuffersMutex);
+        const unsigned int threadId = static_cast<unsigned int>(s_threadBuffers.size());
+        const std::string threadName = t_threadName.empty() ? "Thread " + std::to_string(threadId) : t_threadName;
+        s_threadBuffers.push_back(std::make_unique<ThreadBuffer>(threadId, threadName));
+        t_threadBuffer = s_threadBuffers.back().get();
+    }
+    return t_threadBuffer;
+}
+
+void writeChromeTrace(std::ofstream &file)
+{
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    for (const auto &threadBuffer : s_threadBuffers) {
+        file << (first ? "" : ",\n")
+             << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threadBuffer->threadId
+             << ",\"args\":{\"name\":\"" << threadBuffer->threadName << "\"}}";
+        first = false;
+        const unsigned int count = threadBuffer->count.load(std::memory_order_acquire);
+        for (unsigned int i = 0; i < count; i++) {
+            const Span &span = threadBuffer->spans[i];
+            /* Chrome wants microseconds */
+            file << ",\n{\"name\":\"" << span.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << threadBuffer->threadId
+                 << ",\"ts\":" << (span.startTime - s_startTime) / 1000.0
+                 << ",\"dur\":" << (span.endTime - span.startTime) / 1000.0 << "}";
+        }
+        if (threadBuffer->droppedCount > 0) {
+            std::cout << "Tracer dropped " << threadBuffer->droppedCount << " spans on "
+                      << threadBuffer->threadName << std::endl;
+        }
+    }
+    file << "\n]}\n";
+}
+}
+
+Tracer::ScopedSpan::ScopedSpan(const char *name)
+{
+    if (Tracer::isEnabled()) {
+        m_name = name;
+        m_startTime = Tracer::now();
+    }
+}
+
+Tracer::ScopedSpan::~ScopedSpan()
+{
+    if (m_name) {
+        Tracer::recordSpan(m_name, m_startTime, Tracer::now());
+    }
+}
+
+int64_t Tracer::now()
+{
+    const auto timeSinceEpoch = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(timeSinceEpoch).count();
+}
+
+bool Tracer::isEnabled()
+{
+    return s_enabled.load(std::memory_order_relaxed);
+}
+
+void Tracer::start(const std::string &filename)
+{
+    assert(!s_started);
+    s_started = true;
+    s_filename = filename;
+    s_startTime = now();
+    s_enabled = true;
+}
+
+void Tracer::stop()
+{
+    if (!s_enabled) {
+        return;
+    }
+    s_enabled = false;
+    std::lock_guard<std::mutex> lock(s_threadBuffersMutex);
+    std::ofstream file(s_filename);
+    if (!file.is_open()) {
+        std::cout << "Failed to write trace to " << s_filename << std::endl;
+        return;
+    }
+    writeChromeTrace(file);
+    std::cout << "Wrote trace to " << s_filename << std::endl;
+}
+
+void Tracer::setThreadName(const std::string &name)
+{
+    t_threadName = name;
+    if (t_threadBuffer) {
+        std::lock_guard<std::mutex> lock(s_threadBuffersMutex);
+        t_threadBuffer->threadName = name;
+    }
+}
+
+void Tracer::recordSpan(const char *name, int64_t startTime, int64_t endTime)
+{
+    if (!isEnabled()) {
+        return;
+    }
+    ThreadBuffer *threadBuffer = getThreadBuffer();
+    const unsigned int count = threadBuffer->count.load(std::memory_order_relaxed);
+    if (count == maxSpansPerThread) {
+        threadBuffer->droppedCount++;
+        return;
+    }
+    threadBuffer->spans[count] = { name, startTime, endTime };
+    threadBuffer->count.store(count + 1, std::memory_order_release);
+}
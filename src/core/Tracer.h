@@ -0,0 +1,50 @@
+#ifndef TRACER_H_
+#define TRACER_H_
+
+#include <string>
+#include <cstdint>
+
+/**
+ * Records time spans from all threads (simulation loop, rendering, microcontrollers)
+ * and writes them as Chrome trace-event JSON, which can be opened in chrome://tracing
+ * or Perfetto. Useful for finding stalls, e.g. when the simulation waits for a lock
+ * or a microcontroller is slow to go back to sleep.
+ *
+ * Each thread records into its own fixed-size buffer, which only that thread writes
+ * to, so recording a span doesn't take any locks. When a buffer is full, further
+ * spans of that thread are dropped (and counted). When tracing is not started, a
+ * ScopedSpan costs a single atomic load.
+ *
+ * Span names must be string literals (or otherwise outlive the tracer), because only
+ * the pointer is stored.
+ */
+class Tracer
+{
+public:
+    /** Records the time from construction to destruction as a span on the current thread */
+    class ScopedSpan
+    {
+    public:
+        ScopedSpan(const char *name);
+        ~ScopedSpan();
+    private:
+        const char *m_name = nullptr;
+        int64_t m_startTime = 0;
+    };
+
+    /**
+     * Starts recording. The trace is written to filename when calling stop().
+     * Can only be called once per process.
+     */
+    static void start(const std::string &filename);
+    /** Stops recording and writes the trace. Does nothing if not started. */
+    static void stop();
+    static bool isEnabled();
+    /** Names the current thread in the trace, can be called before start() */
+    static void setThreadName(const std::string &name);
+    static void recordSpan(const char *name, int64_t startTime, int64_t endTime);
+    /** Nanoseconds from an arbitrary fixed point, for recordSpan */
+    static int64_t now();
+};
+
+#endif /* TRACER_H_ */
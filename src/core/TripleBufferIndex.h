@@ -0,0 +1,48 @@
+#ifndef TRIPLE_BUFFER_INDEX_H_
+#define TRIPLE_BUFFER_INDEX_H_
+
+#include <atomic>
+
+/**
+ * Lock-free index exchange for handing snapshots from one writer thread to one reader
+ * thread. The data itself lives elsewhere in arrays of slotCount slots.
+ *
+ * It's double-buffering with a spare slot: the writer always owns one slot and the
+ * reader another, and the third slot holds the latest published snapshot. Publishing
+ * and acquiring are single atomic exchanges, so neither side ever waits for the other.
+ * The reader always gets the most recent complete snapshot (older ones are dropped).
+ */
+class TripleBufferIndex
+{
+public:
+    static constexpr unsigned int slotCount = 3;
+
+    /** Slot the writer should fill in next */
+    unsigned int getWriteSlot() const { return m_writeSlot; }
+    /** Called by the writer when the write slot is complete */
+    void publish()
+    {
+        m_writeSlot = m_sharedSlot.exchange(m_writeSlot | freshBit) & slotMask;
+    }
+    /**
+     * Called by the reader to get the slot with the latest published snapshot. Returns
+     * the same slot as last time if nothing new has been published.
+     */
+    unsigned int acquire()
+    {
+        if (m_sharedSlot.load() & freshBit) {
+            m_readSlot = m_sharedSlot.exchange(m_readSlot) & slotMask;
+        }
+        return m_readSlot;
+    }
+
+private:
+    static constexpr unsigned int freshBit = 0x4;
+    static constexpr unsigned int slotMask = 0x3;
+
+    unsigned int m_writeSlot = 0;
+    std::atomic<unsigned int> m_sharedSlot { 1 };
+    unsigned int m_readSlot = 2;
+};
+
+#endif /* TRIPLE_BUFFER_INDEX_H_ */
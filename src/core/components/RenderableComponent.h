@@ -0,0 +1,112 @@
+#ifndef RENDERABLE_COMPONENT_H_
+#define RENDERABLE_COMPONENT_H_
+
+#include "Component.h"
+#include "TripleBufferIndex.h"
+#include <glm/glm.hpp>
+#include <array>
+
+/**
+ * Base class for components that renders.
+ *
+ * Application doesn't render the live transforms. Instead, the simulation copies the
+ * state needed for rendering into a snapshot slot (storeSnapshot), and the render thread
+ * draws from the latest published slot (renderSnapshot). A snapshot holds the state
+ * before and after the latest step, so rendering can interpolate between them.
+ */
+class RenderableComponent : public Component
+{
+    public:
+        static constexpr unsigned int snapshotSlotCount = TripleBufferIndex::slotCount;
+
+        RenderableComponent() {}
+        virtual ~RenderableComponent() {}
+        /**
+        * Called every simulation iteration (if assigned to a Scene Object).
+        */
+        virtual void onFixedUpdate() = 0;
+        /**
+         * Remembers the current state as the previous state. Called from the simulation
+         * thread before every step.
+         */
+        virtual void storePreviousState() {}
+        /**
+         * Copies the previous and current state into a snapshot slot. Called from the
+         * simulation thread. The default does nothing, override it together with
+         * renderSnapshot (or inherit InterpolatedRenderableComponent).
+         */
+        virtual void storeSnapshot(unsigned int slot)
+        {
+            (void)slot;
+        }
+        /**
+         * Renders the state stored in a snapshot slot, interpolated between the previous
+         * (alpha = 0) and current (alpha = 1) state. Called from the render thread.
+         * The default renders the live state, which is not thread-safe.
+         */
+        virtual void renderSnapshot(unsigned int slot, float alpha)
+        {
+            (void)slot;
+            (void)alpha;
+            onFixedUpdate();
+        }
+        /**
+         * Enable or disable rendering.
+         */
+        void setEnabled(float enabled)
+        {
+            m_enabled = enabled;
+        }
+
+    protected:
+        bool m_enabled = true;
+};
+
+/**
+ * Implements the snapshot handling of RenderableComponent for a given State type.
+ * The derived class provides getState() (read from the transform), interpolate() and
+ * draw(), and must call initSnapshots() in its constructor.
+ */
+template <typename State>
+class InterpolatedRenderableComponent : public RenderableComponent
+{
+    public:
+        void onFixedUpdate() override
+        {
+            draw(getState());
+        }
+        void storePreviousState() override
+        {
+            m_previousState = getState();
+        }
+        void storeSnapshot(unsigned int slot) override
+        {
+            m_snapshots[slot] = { m_previousState, getState() };
+        }
+        void renderSnapshot(unsigned int slot, float alpha) override
+        {
+            const Snapshot &snapshot = m_snapshots[slot];
+            draw(interpolate(snapshot.previous, snapshot.current, alpha));
+        }
+
+    protected:
+        void initSnapshots()
+        {
+            m_previousState = getState();
+            m_snapshots.fill({ m_previousState, m_previousState });
+        }
+        virtual State getState() const = 0;
+        virtual State interpolate(const State &previous, const State &current, float alpha) const = 0;
+        virtual void draw(const State &state) = 0;
+
+    private:
+        struct Snapshot
+        {
+            State previous;
+            State current;
+        };
+        State m_previousState;
+        std::array<Snapshot, snapshotSlotCount> m_snapshots;
+};
+
+#endif /* RENDERABLE_COMPONENT_H_ */
@@ -0,0 +1,36 @@
+#ifndef ANALYTIC_RING_H_
+#define ANALYTIC_RING_H_
+
+#include <glm/glm.hpp>
+
+/**
+ * A ring (annulus) in closed form, e.g. the border of a sumo dohyo. Point tests are
+ * done from the distance to the center, so their cost doesn't depend on how finely
+ * the ring would otherwise have been tessellated into polygons.
+ *
+ * Unscaled units (see PhysicsWorld).
+ */
+struct AnalyticRing
+{
+    glm::vec2 center = { 0.0f, 0.0f };
+    float innerRadius = 0.0f;
+    float outerRadius = 0.0f;
+
+    float getDistanceFromCenter(const glm::vec2 &position) const
+    {
+        return glm::length(position - center);
+    }
+    /** True if the position is on the ring itself (between the inner and outer radius) */
+    bool contains(const glm::vec2 &position) const
+    {
+        const float distance = getDistanceFromCenter(position);
+        return innerRadius <= distance && distance <= outerRadius;
+    }
+    /** True if the position is beyond the outer radius */
+    bool isOutside(const glm::vec2 &position) const
+    {
+        return getDistanceFromCenter(position) > outerRadius;
+    }
+};
+
+#endif /* ANALYTIC_RING_H_ */
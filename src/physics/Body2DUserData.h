@@ -1,14 +1,14 @@
 #ifndef BODY_2D_USER_DATA_H_
 #define BODY_2D_USER_DATA_H_
 
-#include <atomic>
-
-enum class BodyId {LineDetector, Detectable};
+/**
+ * Detectable bodies are detected by line detectors (see LineDetector). They must also have
+ * the detectable collision filter (see Body2D::CollisionFilter::detectable).
+ */
+enum class BodyId { Detectable };
 
 struct Body2DUserData
 {
-    std::atomic<int> contactCount;
-    std::atomic<bool> inContact;
     BodyId bodyId;
 };
 
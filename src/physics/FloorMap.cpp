@@ -0,0 +1,193 @@
+#include "FloorMap.h"
+#include "AnalyticRing.h"
+#include "QuadCoords.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <fstream>
+#include <iostream>
+
+namespace {
+    constexpr unsigned char detectThreshold = 128;
+    /* Quads and rings are sampled on a grid of this many points per axis in each cell */
+    constexpr int coverageSamplesPerAxis = 4;
+
+    float cross(const glm::vec2 &a, const glm::vec2 &b)
+    {
+        return a.x * b.y - a.y * b.x;
+    }
+
+    /** Works for both clockwise and counter-clockwise convex polygons */
+    bool isInsideConvex(const glm::vec2 *vertices, int vertexCount, const glm::vec2 &point)
+    {
+        bool anyPositive = false;
+        bool anyNegative = false;
+        for (int i = 0; i < vertexCount; i++) {
+            const glm::vec2 &v0 = vertices[i];
+            const glm::vec2 &v1 = vertices[(i + 1) % vertexCount];
+            const float side = cross(v1 - v0, point - v0);
+            anyPositive |= side > 0.0f;
+            anyNegative |= side < 0.0f;
+        }
+        return !(anyPositive && anyNegative);
+    }
+
+    /** Reads the next PGM header value, skipping whitespace and comments */
+    bool readPgmValue(std::istream &stream, int &value)
+    {
+        stream >> std::ws;
+        while (stream.peek() == '#') {
+            std::string comment;
+            std::getline(stream, comment);
+            stream >> std::ws;
+        }
+        return static_cast<bool>(stream >> value);
+    }
+}
+
+FloorMap::FloorMap(const glm::vec2 &lowerBound, const glm::vec2 &upperBound, float cellSize) :
+    m_lowerBound(lowerBound),
+    m_cellSize(cellSize)
+{
+    assert(cellSize > 0.0f);
+    assert(upperBound.x > lowerBound.x && upperBound.y > lowerBound.y);
+    m_columns = static_cast<int>(std::ceil((upperBound.x - lowerBound.x) / cellSize));
+    m_rows = static_cast<int>(std::ceil((upperBound.y - lowerBound.y) / cellSize));
+    m_cells.resize(static_cast<size_t>(m_columns) * m_rows, 0);
+}
+
+void FloorMap::addQuad(const QuadCoords &quadCoords)
+{
+    const glm::vec2 vertices[] = { quadCoords.BottomLeft, quadCoords.BottomRight,
+                                   quadCoords.TopRight, quadCoords.TopLeft };
+    glm::vec2 lowerBound = vertices[0];
+    glm::vec2 upperBound = vertices[0];
+    for (const auto &vertex : vertices) {
+        lowerBound = glm::min(lowerBound, vertex);
+        upperBound = glm::max(upperBound, vertex);
+    }
+
+    int firstColumn, firstRow, lastColumn, lastRow;
+    getCellRange(lowerBound, upperBound, firstColumn, firstRow, lastColumn, lastRow);
+    for (int row = firstRow; row <= lastRow; row++) {
+        for (int column = firstColumn; column <= lastColumn; column++) {
+            addCoverage(column, row, [&vertices](const glm::vec2 &point) {
+                return isInsideConvex(vertices, 4, point);
+            });
+        }
+    }
+}
+
+void FloorMap::addRing(const AnalyticRing &ring)
+{
+    const glm::vec2 outerExtent(ring.outerRadius, ring.outerRadius);
+    int firstColumn, firstRow, lastColumn, lastRow;
+    getCellRange(ring.center - outerExtent, ring.center + outerExtent, firstColumn, firstRow, lastColumn, lastRow);
+    for (int row = firstRow; row <= lastRow; row++) {
+        for (int column = firstColumn; column <= lastColumn; column++) {
+            addCoverage(column, row, [&ring](const glm::vec2 &point) {
+                return ring.contains(point);
+            });
+        }
+    }
+}
+
+bool FloorMap::loadImage(const std::string &filepath, LineColor lineColor)
+{
+    std::ifstream file(filepath, std::ios::binary);
+    std::string magic;
+    int width = 0, height = 0, maxValue = 0;
+    if (!(file >> magic) || magic != "P5" || !readPgmValue(file, width) ||
+        !readPgmValue(file, height) || !readPgmValue(file, maxValue) ||
+        width <= 0 || height <= 0 || maxValue <= 0 || maxValue > 255) {
+        std::cout << "Failed to load floor map image " << filepath << std::endl;
+        return false;
+    }
+    /* Exactly one whitespace character separates the header from the pixels */
+    file.get();
+    std::vector<unsigned char> pixels(static_cast<size_t>(width) * height);
+    if (!file.read(reinterpret_cast<char *>(pixels.data()), static_cast<std::streamsize>(pixels.size()))) {
+        std::cout << "Failed to load floor map image " << filepath << std::endl;
+        return false;
+    }
+
+    for (int row = 0; row < m_rows; row++) {
+        /* Image rows go from top to bottom */
+        const int pixelRow = height - 1 - (row * height / m_rows);
+        for (int column = 0; column < m_columns; column++) {
+            const int pixelColumn = column * width / m_columns;
+            int value = pixels[static_cast<size_t>(pixelRow) * width + pixelColumn] * 255 / maxValue;
+            if (lineColor == LineColor::Dark) {
+                value = 255 - value;
+            }
+            setCell(column, row, static_cast<unsigned char>(value));
+        }
+    }
+    return true;
+}
+
+float FloorMap::sample(const glm::vec2 &position) const
+{
+    int column, row;
+    if (!getCell(position, column, row)) {
+        return 0.0f;
+    }
+    return m_cells[static_cast<size_t>(row) * m_columns + column] / 255.0f;
+}
+
+bool FloorMap::isLineDetected(const glm::vec2 &position) const
+{
+    int column, row;
+    if (!getCell(position, column, row)) {
+        return false;
+    }
+    return m_cells[static_cast<size_t>(row) * m_columns + column] >= detectThreshold;
+}
+
+bool FloorMap::getCell(const glm::vec2 &position, int &column, int &row) const
+{
+    const glm::vec2 cellPosition = (position - m_lowerBound) / m_cellSize;
+    if (cellPosition.x < 0.0f || cellPosition.y < 0.0f) {
+        return false;
+    }
+    column = static_cast<int>(cellPosition.x);
+    row = static_cast<int>(cellPosition.y);
+    return column < m_columns && row < m_rows;
+}
+
+void FloorMap::addCoverage(int column, int row, const std::function<bool(const glm::vec2 &)> &isInside)
+{
+    const glm::vec2 cellLowerBound = m_lowerBound + m_cellSize * glm::vec2(column, row);
+    const float sampleSpacing = m_cellSize / coverageSamplesPerAxis;
+    int insideCount = 0;
+    for (int y = 0; y < coverageSamplesPerAxis; y++) {
+        for (int x = 0; x < coverageSamplesPerAxis; x++) {
+            const glm::vec2 point = cellLowerBound + sampleSpacing * glm::vec2(x + 0.5f, y + 0.5f);
+            insideCount += isInside(point) ? 1 : 0;
+        }
+    }
+    constexpr int sampleCount = coverageSamplesPerAxis * coverageSamplesPerAxis;
+    /* Rounded, so a cell that is half covered reaches the detection threshold */
+    const int coverage = (insideCount * 255 + sampleCount / 2) / sampleCount;
+    unsigned char &cell = m_cells[static_cast<size_t>(row) * m_columns + column];
+    /* Overlapping lines don't add up */
+    cell = std::max(cell, static_cast<unsigned char>(coverage));
+}
+
+void FloorMap::setCell(int column, int row, unsigned char value)
+{
+    m_cells[static_cast<size_t>(row) * m_columns + column] = value;
+}
+
+void FloorMap::getCellRange(const glm::vec2 &lowerBound, const glm::vec2 &upperBound,
+                            int &firstColumn, int &firstRow, int &lastColumn, int &lastRow) const
+{
+    const glm::vec2 first = glm::floor((lowerBound - m_lowerBound) / m_cellSize);
+    const glm::vec2 last = glm::floor((upperBound - m_lowerBound) / m_cellSize);
+    firstColumn = std::max(0, static_cast<int>(first.x));
+    firstRow = std::max(0, static_cast<int>(first.y));
+    lastColumn = std::min(m_columns - 1, static_cast<int>(last.x));
+    lastRow = std::min(m_rows - 1, static_cast<int>(last.y));
+}
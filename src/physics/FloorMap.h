@@ -0,0 +1,63 @@
+#ifndef FLOOR_MAP_H_
+#define FLOOR_MAP_H_
+
+#include <glm/glm.hpp>
+#include <functional>
+#include <string>
+#include <vector>
+
+struct QuadCoords;
+struct AnalyticRing;
+
+/**
+ * A rasterized map of the floor, which line detectors sample by position instead of
+ * querying the fixtures below them (see LineDetector). Detection is then a lookup in a
+ * grid regardless of how many quads the lines are made of.
+ *
+ * Each cell holds how much of it is covered by line (0-255), and a line is detected in
+ * cells at or above half. Lines are drawn from quads (e.g. LineFollowerPath), rings (e.g.
+ * the Dohyo border) or a grayscale image. The coverage of quads and rings is estimated
+ * from a grid of sample points in each cell, an image gives it by its gray levels.
+ * Positions outside the map have no line.
+ *
+ * Unscaled units (see PhysicsWorld). The map must be complete before the simulation
+ * starts, because it's read by the physics step without locking.
+ */
+class FloorMap
+{
+public:
+    /** Which pixels of a loaded image are lines */
+    enum class LineColor { Dark, Bright };
+    FloorMap(const glm::vec2 &lowerBound, const glm::vec2 &upperBound, float cellSize);
+
+    /** Draws a line quad. NOTE: Coordinates must form a convex polygon. */
+    void addQuad(const QuadCoords &quadCoords);
+    /** Draws a line ring, i.e. the area between its inner and outer radius */
+    void addRing(const AnalyticRing &ring);
+    /**
+     * Draws lines from a binary PGM (P5) grayscale image, which is stretched across the
+     * map. Returns false if the file can't be read.
+     */
+    bool loadImage(const std::string &filepath, LineColor lineColor);
+    /** Returns the line coverage at the position (0-1) */
+    float sample(const glm::vec2 &position) const;
+    bool isLineDetected(const glm::vec2 &position) const;
+
+private:
+    /** Returns false if the position is outside the map */
+    bool getCell(const glm::vec2 &position, int &column, int &row) const;
+    /** Raises the cell's coverage to the fraction of it that is inside the shape */
+    void addCoverage(int column, int row, const std::function<bool(const glm::vec2 &)> &isInside);
+    void setCell(int column, int row, unsigned char value);
+    /** Clamps the bounds to the cells of the map */
+    void getCellRange(const glm::vec2 &lowerBound, const glm::vec2 &upperBound,
+                      int &firstColumn, int &firstRow, int &lastColumn, int &lastRow) const;
+
+    const glm::vec2 m_lowerBound;
+    const float m_cellSize;
+    int m_columns = 0;
+    int m_rows = 0;
+    std::vector<unsigned char> m_cells;
+};
+
+#endif /* FLOOR_MAP_H_ */
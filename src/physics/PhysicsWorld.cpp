@@ -1,5 +1,9 @@
 #include "PhysicsWorld.h"
-#include "ContactListener.h"
+#include "RangeSensorSystem.h"
+#include "TopViewFriction.h"
+#include "FloorMap.h"
+#include "VoltageLines.h"
+#include "Profiler.h"
 
 #include "box2d/box2d.h"
 #include <cassert>
@@ -15,6 +19,13 @@ constexpr float massScaleFactor { physScaleFactor * physScaleFactor * physScaleF
 /* F = m*a so F_scaled = forceFactor * F = (massFactor * m) * (accFactor * a) */
 const float forceScaleFactor { massScaleFactor * accelerationScaleFactor };
 constexpr float gravitationConstant { 9.82f };
+/* Weight of the newest step in the rolling average of the step stats */
+constexpr float stepStatsAverageWeight { 0.01f };
+
+float rollingAverage(float average, float value)
+{
+    return average + stepStatsAverageWeight * (value - average);
+}
 }
 
 void PhysicsWorld::assertDimensions(float unscaledLength)
@@ -112,8 +123,12 @@ float PhysicsWorld::normalForce(float unscaledMass)
 
 void PhysicsWorld::init()
 {
-    m_contactListener = std::make_unique<ContactListener>();
-    m_world->SetContactListener(m_contactListener.get());
+    m_rangeSensorSystem = std::make_unique<RangeSensorSystem>();
+    m_topViewFriction = std::make_unique<TopViewFriction>();
+    m_voltageLines = std::make_unique<VoltageLines>();
+    /* Friction and forces are cleared once per step rather than per sub-step */
+    m_world->SetAutoClearForces(false);
+    applySettings();
 }
 
 PhysicsWorld::PhysicsWorld(Gravity gravity) :
@@ -151,7 +166,192 @@ PhysicsWorld::~PhysicsWorld()
 
 void PhysicsWorld::step(float stepTime)
 {
-    /* The iteration values 6 and 2 are recommended value taken from elsewhere.
-       They matter when calculating collision. */
-    m_world->Step(stepTime, 6, 2);
+    Profiler::ScopedTimer timer(Profiler::Phase::PhysicsWorldStep);
+    const Settings &settings = getActiveSettings();
+    const float subStepTime = stepTime / settings.subStepCount;
+    StepStats stepStats;
+    for (unsigned int i = 0; i < settings.subStepCount; i++) {
+        m_topViewFriction->apply(subStepTime);
+        m_world->Step(subStepTime, settings.velocityIterations, settings.positionIterations);
+        const b2Profile &profile = m_world->GetProfile();
+        stepStats.step += profile.step;
+        stepStats.collide += profile.collide;
+        stepStats.solve += profile.solve;
+        stepStats.solveInit += profile.solveInit;
+        stepStats.solveVelocity += profile.solveVelocity;
+        stepStats.solvePosition += profile.solvePosition;
+        stepStats.broadphase += profile.broadphase;
+        stepStats.solveTOI += profile.solveTOI;
+    }
+    stepStats.bodyCount = m_world->GetBodyCount();
+    stepStats.contactCount = m_world->GetContactCount();
+    stepStats.jointCount = m_world->GetJointCount();
+    stepStats.proxyCount = m_world->GetProxyCount();
+    updateStepStats(stepStats);
+    m_world->ClearForces();
+    m_topViewFriction->clearForces();
+    m_rangeSensorSystem->update();
+}
+
+void PhysicsWorld::updateStepStats(const StepStats &stepStats)
+{
+    m_stepStats = stepStats;
+    if (m_stepStatsCount++ == 0) {
+        m_averageStepStats = stepStats;
+        return;
+    }
+    m_averageStepStats.step = rollingAverage(m_averageStepStats.step, stepStats.step);
+    m_averageStepStats.collide = rollingAverage(m_averageStepStats.collide, stepStats.collide);
+    m_averageStepStats.solve = rollingAverage(m_averageStepStats.solve, stepStats.solve);
+    m_averageStepStats.solveInit = rollingAverage(m_averageStepStats.solveInit, stepStats.solveInit);
+    m_averageStepStats.solveVelocity = rollingAverage(m_averageStepStats.solveVelocity, stepStats.solveVelocity);
+    m_averageStepStats.solvePosition = rollingAverage(m_averageStepStats.solvePosition, stepStats.solvePosition);
+    m_averageStepStats.broadphase = rollingAverage(m_averageStepStats.broadphase, stepStats.broadphase);
+    m_averageStepStats.solveTOI = rollingAverage(m_averageStepStats.solveTOI, stepStats.solveTOI);
+    m_averageStepStats.bodyCount = stepStats.bodyCount;
+    m_averageStepStats.contactCount = stepStats.contactCount;
+    m_averageStepStats.jointCount = stepStats.jointCount;
+    m_averageStepStats.proxyCount = stepStats.proxyCount;
+}
+
+PhysicsWorld::Settings PhysicsWorld::getBenchmarkSettings()
+{
+    Settings settings;
+    settings.velocityIterations = 3;
+    settings.positionIterations = 1;
+    settings.continuousPhysics = false;
+    return settings;
+}
+
+void PhysicsWorld::setSettings(const Settings &settings)
+{
+    assert(settings.velocityIterations > 0 && settings.positionIterations > 0);
+    assert(settings.subStepCount > 0);
+    m_settings = settings;
+    applySettings();
+}
+
+void PhysicsWorld::setBenchmarkEnabled(bool enabled)
+{
+    m_benchmarkEnabled = enabled;
+    applySettings();
+}
+
+const PhysicsWorld::Settings &PhysicsWorld::getActiveSettings() const
+{
+    return m_benchmarkEnabled ? m_benchmarkSettings : m_settings;
+}
+
+/**
+ * Applies the settings that Box2D keeps itself. The iterations and sub-steps are used
+ * directly when stepping.
+ */
+void PhysicsWorld::applySettings()
+{
+    const Settings &settings = getActiveSettings();
+    m_world->SetAllowSleeping(settings.allowSleep);
+    m_world->SetWarmStarting(settings.warmStarting);
+    m_world->SetContinuousPhysics(settings.continuousPhysics);
+    for (b2Body *body = m_world->GetBodyList(); body != nullptr; body = body->GetNext()) {
+        if (body->GetType() == b2_dynamicBody) {
+            body->SetBullet(settings.bulletBodies);
+        }
+    }
+}
+
+RangeSensorSystem *PhysicsWorld::getRangeSensorSystem() const
+{
+    return m_rangeSensorSystem.get();
+}
+
+void PhysicsWorld::setTopViewFrictionMode(TopViewFrictionMode mode)
+{
+    assert(m_world->GetBodyCount() == 0);
+    m_topViewFrictionMode = mode;
+}
+
+TopViewFriction *PhysicsWorld::getTopViewFriction() const
+{
+    return m_topViewFriction.get();
+}
+
+FloorMap *PhysicsWorld::createFloorMap(const glm::vec2 &lowerBound, const glm::vec2 &upperBound, float cellSize)
+{
+    assert(!m_floorMap);
+    m_floorMap = std::make_unique<FloorMap>(lowerBound, upperBound, cellSize);
+    return m_floorMap.get();
+}
+
+FloorMap *PhysicsWorld::getFloorMap() const
+{
+    return m_floorMap.get();
+}
+
+int16_t PhysicsWorld::createCollisionGroup()
+{
+    assert(m_lastCollisionGroup > INT16_MIN);
+    return --m_lastCollisionGroup;
+}
+
+VoltageLines *PhysicsWorld::getVoltageLines() const
+{
+    return m_voltageLines.get();
+}
+
+void PhysicsWorld::snapshot(Snapshot &snapshot) const
+{
+    snapshot.bodies.clear();
+    for (const b2Body *body = m_world->GetBodyList(); body != nullptr; body = body->GetNext()) {
+        if (body->GetType() == b2_staticBody) {
+            continue;
+        }
+        Snapshot::BodyState bodyState;
+        const b2Vec2 &position = body->GetPosition();
+        const b2Vec2 &linearVelocity = body->GetLinearVelocity();
+        bodyState.position = { position.x, position.y };
+        bodyState.angle = body->GetAngle();
+        bodyState.linearVelocity = { linearVelocity.x, linearVelocity.y };
+        bodyState.angularVelocity = body->GetAngularVelocity();
+        bodyState.awake = body->IsAwake();
+        snapshot.bodies.push_back(bodyState);
+    }
+
+    snapshot.voltageLines.clear();
+    for (const float *voltageLine : m_voltageLines->get()) {
+        snapshot.voltageLines.push_back(*voltageLine);
+    }
+}
+
+void PhysicsWorld::restore(const Snapshot &snapshot)
+{
+    assert(!m_world->IsLocked());
+    /* The body list order is stable as long as no bodies are created or destroyed */
+    auto bodyStateItr = snapshot.bodies.begin();
+    for (b2Body *body = m_world->GetBodyList(); body != nullptr; body = body->GetNext()) {
+        if (body->GetType() == b2_staticBody) {
+            continue;
+        }
+        assert(bodyStateItr != snapshot.bodies.end());
+        const Snapshot::BodyState &bodyState = *bodyStateItr++;
+        body->SetTransform(b2Vec2(bodyState.position.x, bodyState.position.y), bodyState.angle);
+        if (bodyState.awake) {
+            body->SetAwake(true);
+            body->SetLinearVelocity(b2Vec2(bodyState.linearVelocity.x, bodyState.linearVelocity.y));
+            body->SetAngularVelocity(bodyState.angularVelocity);
+        } else {
+            /* Also zeroes the velocities */
+            body->SetAwake(false);
+        }
+    }
+    assert(bodyStateItr == snapshot.bodies.end());
+
+    const std::vector<float *> &voltageLines = m_voltageLines->get();
+    assert(voltageLines.size() == snapshot.voltageLines.size());
+    for (size_t i = 0; i < voltageLines.size(); i++) {
+        *voltageLines[i] = snapshot.voltageLines[i];
+    }
+
+    /* Forces applied since the last step belong to the discarded state */
+    m_world->ClearForces();
+    m_topViewFriction->clearForces();
 }
@@ -3,9 +3,14 @@
 
 #include <glm/glm.hpp>
 #include <memory>
+#include <vector>
+#include <cstdint>
 
 class b2World;
-class ContactListener;
+class RangeSensorSystem;
+class TopViewFriction;
+class FloorMap;
+class VoltageLines;
 
 /**
  * Wrapper class around Box2D b2World. Only one instance should exist at a time.
@@ -27,13 +32,124 @@ public:
      * to set specific gravity constant for X and Y axis.
      */
     enum class Gravity { SideView, TopView, Custom };
+    /**
+     * How ground friction is simulated in top view mode. Integrator applies the friction
+     * directly to the bodies each step (see TopViewFriction). Joint uses a b2FrictionJoint
+     * to an extra static body per body, which is solved together with the contacts, but
+     * doubles the solver work.
+     */
+    enum class TopViewFrictionMode { Integrator, Joint };
+    /**
+     * Solver and stepping settings, which trade accuracy for speed. The defaults are
+     * the Box2D recommendations, see getBenchmarkSettings() for a faster alternative.
+     */
+    struct Settings {
+        int velocityIterations = 6;
+        int positionIterations = 2;
+        /** Let bodies at rest sleep, so they're skipped until something wakes them */
+        bool allowSleep = true;
+        /** Start the solver from the previous step's impulses */
+        bool warmStarting = true;
+        /** Continuous collision between dynamic and static bodies (prevents tunneling) */
+        bool continuousPhysics = true;
+        /** Continuous collision between dynamic bodies too, e.g. for fast bots */
+        bool bulletBodies = false;
+        /** Splits each step into this many Box2D steps */
+        unsigned int subStepCount = 1;
+    };
+    static Settings getBenchmarkSettings();
+    /**
+     * Where the time of a step goes, from the Box2D profile (see b2Profile), and the size
+     * of the world. With sub-steps, the times are summed over the sub-steps.
+     */
+    struct StepStats {
+        /** Milliseconds */
+        float step = 0.0f;
+        float collide = 0.0f;
+        float solve = 0.0f;
+        float solveInit = 0.0f;
+        float solveVelocity = 0.0f;
+        float solvePosition = 0.0f;
+        float broadphase = 0.0f;
+        float solveTOI = 0.0f;
+        unsigned int bodyCount = 0;
+        unsigned int contactCount = 0;
+        unsigned int jointCount = 0;
+        unsigned int proxyCount = 0;
+    };
+    /**
+     * The state of the simulation at one point in time, see snapshot(). Reuse the same
+     * snapshot to avoid allocating when taking it again.
+     */
+    struct Snapshot {
+        /** Box2D (scaled) units */
+        struct BodyState {
+            glm::vec2 position;
+            float angle = 0.0f;
+            glm::vec2 linearVelocity;
+            float angularVelocity = 0.0f;
+            bool awake = true;
+        };
+        std::vector<BodyState> bodies;
+        std::vector<float> voltageLines;
+    };
     PhysicsWorld(Gravity gravity);
     PhysicsWorld(float gravityX, float gravityY);
     ~PhysicsWorld();
     void init();
 
+    /** Steps the Box2D world and then updates all range sensors (see RangeSensorSystem) */
     void step(float stepTime);
     inline Gravity getGravityType() const { return m_gravityType; }
+    /** Settings can be changed at any time, typically by the Scene when it's created */
+    void setSettings(const Settings &settings);
+    const Settings &getSettings() const { return m_settings; }
+    /**
+     * Use the benchmark settings instead of the settings set with setSettings, e.g. for
+     * higher throughput in batch runs. The settings are kept and restored when disabled.
+     */
+    void setBenchmarkEnabled(bool enabled);
+    bool isBenchmarkEnabled() const { return m_benchmarkEnabled; }
+    /** The settings currently used, i.e. the benchmark settings when enabled */
+    const Settings &getActiveSettings() const;
+    RangeSensorSystem *getRangeSensorSystem() const;
+    /** Must be set before any bodies are created */
+    void setTopViewFrictionMode(TopViewFrictionMode mode);
+    TopViewFrictionMode getTopViewFrictionMode() const { return m_topViewFrictionMode; }
+    TopViewFriction *getTopViewFriction() const;
+    /**
+     * Creates a floor map, which line detectors then sample instead of querying the
+     * Box2D world (see FloorMap). Create it before the objects that draw lines on it
+     * (e.g. LineFollowerPath and Dohyo). Unscaled units.
+     */
+    FloorMap *createFloorMap(const glm::vec2 &lowerBound, const glm::vec2 &upperBound, float cellSize);
+    /** Returns nullptr if no floor map has been created */
+    FloorMap *getFloorMap() const;
+    /**
+     * Returns a new negative collision group, for bodies that shouldn't make contacts
+     * with each other (see Body2D::CollisionFilter)
+     */
+    int16_t createCollisionGroup();
+    /** Stats of the last step */
+    const StepStats &getStepStats() const { return m_stepStats; }
+    /** Rolling average of the step stats (roughly the last 100 steps), counters are from the last step */
+    const StepStats &getAverageStepStats() const { return m_averageStepStats; }
+    /** Voltage lines to include in snapshots, see VoltageLines */
+    VoltageLines *getVoltageLines() const;
+    /**
+     * Saves the pose and velocity of every non-static body and the value of every voltage
+     * line, e.g. to reset an episode with restore() instead of recreating the scene.
+     */
+    void snapshot(Snapshot &snapshot) const;
+    /**
+     * Rolls back to a snapshot. The world must have the same bodies and voltage lines as
+     * when the snapshot was taken. Must not be called during a step.
+     *
+     * NOTE: Box2D doesn't expose the joint and contact impulses it warm starts from, so
+     * the first step after restoring may differ slightly from the original. The state of
+     * the controllers (e.g. microcontroller threads) isn't included either.
+     */
+    void restore(const Snapshot &snapshot);
 
     static void assertDimensions(float unscaledLength);
     static float scaleLength(float unscaledLength);
@@ -56,9 +172,23 @@ public:
     /** To give physics components to access to b2World */
     friend class PhysicsComponent;
 private:
+    void applySettings();
+    void updateStepStats(const StepStats &stepStats);
+
     std::unique_ptr<b2World> m_world;
-    std::unique_ptr<ContactListener> m_contactListener;
+    std::unique_ptr<RangeSensorSystem> m_rangeSensorSystem;
+    std::unique_ptr<TopViewFriction> m_topViewFriction;
+    std::unique_ptr<FloorMap> m_floorMap;
+    std::unique_ptr<VoltageLines> m_voltageLines;
     Gravity m_gravityType = Gravity::SideView;
+    TopViewFrictionMode m_topViewFrictionMode = TopViewFrictionMode::Integrator;
+    Settings m_settings;
+    Settings m_benchmarkSettings = getBenchmarkSettings();
+    bool m_benchmarkEnabled = false;
+    StepStats m_stepStats;
+    StepStats m_averageStepStats;
+    unsigned int m_stepStatsCount = 0;
+    int16_t m_lastCollisionGroup = 0;
 };
 
 #endif /* PHYSICS_WORLD_H_ */
@@ -0,0 +1,55 @@
+#include "RangeSensorSystem.h"
+#include "components/RangeSensor.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace {
+/* A ray cast takes around a microsecond, so fewer rays per job than this aren't worth
+ * waking up the worker threads for */
+const unsigned int raysPerJob = 16;
+}
+
+RangeSensorSystem::RangeSensorSystem() :
+    m_threadPool(&ThreadPool::getShared())
+{
+}
+
+void RangeSensorSystem::addSensor(RangeSensor *rangeSensor)
+{
+    assert(rangeSensor != nullptr);
+    m_rangeSensors.push_back(rangeSensor);
+}
+
+void RangeSensorSystem::removeSensor(RangeSensor *rangeSensor)
+{
+    auto itr = std::find(m_rangeSensors.begin(), m_rangeSensors.end(), rangeSensor);
+    if (itr != m_rangeSensors.end()) {
+        m_rangeSensors.erase(itr);
+    }
+}
+
+void RangeSensorSystem::setThreadPool(ThreadPool *threadPool)
+{
+    m_threadPool = threadPool;
+}
+
+void RangeSensorSystem::update()
+{
+    const unsigned int sensorCount = static_cast<unsigned int>(m_rangeSensors.size());
+    if (m_threadPool == nullptr || sensorCount < 2 * raysPerJob) {
+        for (auto rangeSensor : m_rangeSensors) {
+            rangeSensor->castRay();
+        }
+        return;
+    }
+
+    const unsigned int jobCount = (sensorCount + raysPerJob - 1) / raysPerJob;
+    m_threadPool->parallelFor(jobCount, [this, sensorCount](unsigned int job) {
+        const unsigned int end = std::min((job + 1) * raysPerJob, sensorCount);
+        for (unsigned int i = job * raysPerJob; i < end; i++) {
+            m_rangeSensors[i]->castRay();
+        }
+    });
+}
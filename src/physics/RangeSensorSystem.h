@@ -0,0 +1,32 @@
+#ifndef RANGE_SENSOR_SYSTEM_H_
+#define RANGE_SENSOR_SYSTEM_H_
+
+#include <vector>
+
+class RangeSensor;
+class ThreadPool;
+
+/**
+ * Casts the rays of all range sensors in a PhysicsWorld in one batch right after the
+ * physics step. The world is read-only between steps, so the rays are independent
+ * and are spread across the threads of a ThreadPool when there are enough of them.
+ * Each sensor's distance and voltage line are updated before the batch returns.
+ *
+ * Range sensors add and remove themselves, so this is never used directly.
+ */
+class RangeSensorSystem
+{
+public:
+    RangeSensorSystem();
+    void addSensor(RangeSensor *rangeSensor);
+    void removeSensor(RangeSensor *rangeSensor);
+    /** Null casts the rays serially, defaults to ThreadPool::getShared() */
+    void setThreadPool(ThreadPool *threadPool);
+    void update();
+
+private:
+    std::vector<RangeSensor *> m_rangeSensors;
+    ThreadPool *m_threadPool = nullptr;
+};
+
+#endif /* RANGE_SENSOR_SYSTEM_H_ */
@@ -0,0 +1,236 @@
+#include "RayTargets.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cassert>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define RAY_TARGETS_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RAY_TARGETS_SSE2
+#endif
+
+namespace {
+/* Same as b2_epsilon */
+constexpr float epsilon = 1.192092896e-07f;
+
+struct Ray {
+    float startX;
+    float startY;
+    float deltaX;
+    float deltaY;
+    /* Squared length of the ray */
+    float lengthSquared;
+};
+
+/* Scalar version of the circle test, see b2CircleShape::RayCast */
+float castRayCircle(const Ray &ray, float centerX, float centerY, float radius, float closest)
+{
+    const float sx = ray.startX - centerX;
+    const float sy = ray.startY - centerY;
+    const float b = sx * sx + sy * sy - radius * radius;
+    const float c = sx * ray.deltaX + sy * ray.deltaY;
+    const float sigma = c * c - ray.lengthSquared * b;
+    if (sigma < 0.0f) {
+        return closest;
+    }
+    const float a = -(c + std::sqrt(sigma));
+    if (0.0f <= a && a < closest * ray.lengthSquared) {
+        return a / ray.lengthSquared;
+    }
+    return closest;
+}
+
+/* Scalar version of the edge test, an edge is only hit from its outside (right) side */
+float castRayEdge(const Ray &ray, float edgeX, float edgeY, float edgeDeltaX, float edgeDeltaY, float closest)
+{
+    /* Negative when the ray enters through the edge (counter-clockwise polygon) */
+    const float denominator = ray.deltaX * edgeDeltaY - ray.deltaY * edgeDeltaX;
+    if (denominator > -epsilon) {
+        return closest;
+    }
+    const float ox = edgeX - ray.startX;
+    const float oy = edgeY - ray.startY;
+    const float t = (ox * edgeDeltaY - oy * edgeDeltaX) / denominator;
+    const float u = (ox * ray.deltaY - oy * ray.deltaX) / denominator;
+    if (0.0f <= t && t < closest && 0.0f <= u && u <= 1.0f) {
+        return t;
+    }
+    return closest;
+}
+
+#if defined(RAY_TARGETS_AVX2)
+float horizontalMin(__m256 values)
+{
+    const __m128 half = _mm_min_ps(_mm256_castps256_ps128(values), _mm256_extractf128_ps(values, 1));
+    const __m128 quarter = _mm_min_ps(half, _mm_movehl_ps(half, half));
+    return _mm_cvtss_f32(_mm_min_ss(quarter, _mm_shuffle_ps(quarter, quarter, 1)));
+}
+#elif defined(RAY_TARGETS_SSE2)
+float horizontalMin(__m128 values)
+{
+    const __m128 half = _mm_min_ps(values, _mm_movehl_ps(values, values));
+    return _mm_cvtss_f32(_mm_min_ss(half, _mm_shuffle_ps(half, half, 1)));
+}
+#endif
+}
+
+void RayTargets::clear()
+{
+    m_circleX.clear();
+    m_circleY.clear();
+    m_circleRadius.clear();
+    m_edgeX.clear();
+    m_edgeY.clear();
+    m_edgeDeltaX.clear();
+    m_edgeDeltaY.clear();
+}
+
+void RayTargets::addCircle(const glm::vec2 &center, float radius)
+{
+    assert(radius > 0.0f);
+    m_circleX.push_back(center.x);
+    m_circleY.push_back(center.y);
+    m_circleRadius.push_back(radius);
+}
+
+void RayTargets::addEdge(const glm::vec2 &start, const glm::vec2 &end)
+{
+    m_edgeX.push_back(start.x);
+    m_edgeY.push_back(start.y);
+    m_edgeDeltaX.push_back(end.x - start.x);
+    m_edgeDeltaY.push_back(end.y - start.y);
+}
+
+void RayTargets::addPolygon(const glm::vec2 *vertices, unsigned int vertexCount)
+{
+    assert(vertexCount >= 3);
+    for (unsigned int i = 0; i < vertexCount; i++) {
+        addEdge(vertices[i], vertices[(i + 1) % vertexCount]);
+    }
+}
+
+void RayTargets::addSegment(const glm::vec2 &start, const glm::vec2 &end)
+{
+    /* Add it in both directions, because edges are one-sided */
+    addEdge(start, end);
+    addEdge(end, start);
+}
+
+/**
+ * The SIMD loops test a full register of shapes at a time and keep the closest hit per
+ * lane, the shapes that don't fill a register are tested with the scalar functions.
+ */
+float RayTargets::castRay(const glm::vec2 &start, const glm::vec2 &end) const
+{
+    const float deltaX = end.x - start.x;
+    const float deltaY = end.y - start.y;
+    const Ray ray = { start.x, start.y, deltaX, deltaY, deltaX * deltaX + deltaY * deltaY };
+    if (ray.lengthSquared < epsilon) {
+        return 1.0f;
+    }
+    float closest = 1.0f;
+    const unsigned int circleCount = static_cast<unsigned int>(m_circleX.size());
+    const unsigned int edgeCount = static_cast<unsigned int>(m_edgeX.size());
+    unsigned int circleIdx = 0;
+    unsigned int edgeIdx = 0;
+
+#if defined(RAY_TARGETS_AVX2)
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 startX = _mm256_set1_ps(ray.startX);
+    const __m256 startY = _mm256_set1_ps(ray.startY);
+    const __m256 rayDeltaX = _mm256_set1_ps(ray.deltaX);
+    const __m256 rayDeltaY = _mm256_set1_ps(ray.deltaY);
+    const __m256 lengthSquared = _mm256_set1_ps(ray.lengthSquared);
+    const __m256 minusEpsilon = _mm256_set1_ps(-epsilon);
+    __m256 closestFractions = one;
+
+    for (; circleIdx + 8 <= circleCount; circleIdx += 8) {
+        const __m256 radius = _mm256_loadu_ps(&m_circleRadius[circleIdx]);
+        const __m256 sx = _mm256_sub_ps(startX, _mm256_loadu_ps(&m_circleX[circleIdx]));
+        const __m256 sy = _mm256_sub_ps(startY, _mm256_loadu_ps(&m_circleY[circleIdx]));
+        const __m256 b = _mm256_sub_ps(_mm256_add_ps(_mm256_mul_ps(sx, sx), _mm256_mul_ps(sy, sy)),
+                                       _mm256_mul_ps(radius, radius));
+        const __m256 c = _mm256_add_ps(_mm256_mul_ps(sx, rayDeltaX), _mm256_mul_ps(sy, rayDeltaY));
+        const __m256 sigma = _mm256_sub_ps(_mm256_mul_ps(c, c), _mm256_mul_ps(lengthSquared, b));
+        /* Negative sigma (miss) gives NaN, which fails all the comparisons below */
+        const __m256 a = _mm256_sub_ps(zero, _mm256_add_ps(c, _mm256_sqrt_ps(sigma)));
+        const __m256 fractions = _mm256_div_ps(a, lengthSquared);
+        const __m256 hit = _mm256_and_ps(_mm256_cmp_ps(a, zero, _CMP_GE_OQ),
+                                         _mm256_cmp_ps(fractions, closestFractions, _CMP_LT_OQ));
+        closestFractions = _mm256_blendv_ps(closestFractions, fractions, hit);
+    }
+
+    for (; edgeIdx + 8 <= edgeCount; edgeIdx += 8) {
+        const __m256 edgeDeltaX = _mm256_loadu_ps(&m_edgeDeltaX[edgeIdx]);
+        const __m256 edgeDeltaY = _mm256_loadu_ps(&m_edgeDeltaY[edgeIdx]);
+        const __m256 denominator = _mm256_sub_ps(_mm256_mul_ps(rayDeltaX, edgeDeltaY),
+                                                 _mm256_mul_ps(rayDeltaY, edgeDeltaX));
+        const __m256 ox = _mm256_sub_ps(_mm256_loadu_ps(&m_edgeX[edgeIdx]), startX);
+        const __m256 oy = _mm256_sub_ps(_mm256_loadu_ps(&m_edgeY[edgeIdx]), startY);
+        const __m256 t = _mm256_div_ps(_mm256_sub_ps(_mm256_mul_ps(ox, edgeDeltaY), _mm256_mul_ps(oy, edgeDeltaX)), denominator);
+        const __m256 u = _mm256_div_ps(_mm256_sub_ps(_mm256_mul_ps(ox, rayDeltaY), _mm256_mul_ps(oy, rayDeltaX)), denominator);
+        __m256 hit = _mm256_cmp_ps(denominator, minusEpsilon, _CMP_LT_OQ);
+        hit = _mm256_and_ps(hit, _mm256_cmp_ps(t, zero, _CMP_GE_OQ));
+        hit = _mm256_and_ps(hit, _mm256_cmp_ps(t, closestFractions, _CMP_LT_OQ));
+        hit = _mm256_and_ps(hit, _mm256_cmp_ps(u, zero, _CMP_GE_OQ));
+        hit = _mm256_and_ps(hit, _mm256_cmp_ps(u, one, _CMP_LE_OQ));
+        closestFractions = _mm256_blendv_ps(closestFractions, t, hit);
+    }
+    closest = horizontalMin(closestFractions);
+#elif defined(RAY_TARGETS_SSE2)
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 startX = _mm_set1_ps(ray.startX);
+    const __m128 startY = _mm_set1_ps(ray.startY);
+    const __m128 rayDeltaX = _mm_set1_ps(ray.deltaX);
+    const __m128 rayDeltaY = _mm_set1_ps(ray.deltaY);
+    const __m128 lengthSquared = _mm_set1_ps(ray.lengthSquared);
+    const __m128 minusEpsilon = _mm_set1_ps(-epsilon);
+    __m128 closestFractions = one;
+
+    for (; circleIdx + 4 <= circleCount; circleIdx += 4) {
+        const __m128 radius = _mm_loadu_ps(&m_circleRadius[circleIdx]);
+        const __m128 sx = _mm_sub_ps(startX, _mm_loadu_ps(&m_circleX[circleIdx]));
+        const __m128 sy = _mm_sub_ps(startY, _mm_loadu_ps(&m_circleY[circleIdx]));
+        const __m128 b = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(sx, sx), _mm_mul_ps(sy, sy)),
+                                    _mm_mul_ps(radius, radius));
+        const __m128 c = _mm_add_ps(_mm_mul_ps(sx, rayDeltaX), _mm_mul_ps(sy, rayDeltaY));
+        const __m128 sigma = _mm_sub_ps(_mm_mul_ps(c, c), _mm_mul_ps(lengthSquared, b));
+        /* Negative sigma (miss) gives NaN, which fails all the comparisons below */
+        const __m128 a = _mm_sub_ps(zero, _mm_add_ps(c, _mm_sqrt_ps(sigma)));
+        const __m128 fractions = _mm_div_ps(a, lengthSquared);
+        const __m128 hit = _mm_and_ps(_mm_cmpge_ps(a, zero), _mm_cmplt_ps(fractions, closestFractions));
+        closestFractions = _mm_or_ps(_mm_and_ps(hit, fractions), _mm_andnot_ps(hit, closestFractions));
+    }
+
+    for (; edgeIdx + 4 <= edgeCount; edgeIdx += 4) {
+        const __m128 edgeDeltaX = _mm_loadu_ps(&m_edgeDeltaX[edgeIdx]);
+        const __m128 edgeDeltaY = _mm_loadu_ps(&m_edgeDeltaY[edgeIdx]);
+        const __m128 denominator = _mm_sub_ps(_mm_mul_ps(rayDeltaX, edgeDeltaY), _mm_mul_ps(rayDeltaY, edgeDeltaX));
+        const __m128 ox = _mm_sub_ps(_mm_loadu_ps(&m_edgeX[edgeIdx]), startX);
+        const __m128 oy = _mm_sub_ps(_mm_loadu_ps(&m_edgeY[edgeIdx]), startY);
+        const __m128 t = _mm_div_ps(_mm_sub_ps(_mm_mul_ps(ox, edgeDeltaY), _mm_mul_ps(oy, edgeDeltaX)), denominator);
+        const __m128 u = _mm_div_ps(_mm_sub_ps(_mm_mul_ps(ox, rayDeltaY), _mm_mul_ps(oy, rayDeltaX)), denominator);
+        __m128 hit = _mm_cmplt_ps(denominator, minusEpsilon);
+        hit = _mm_and_ps(hit, _mm_cmpge_ps(t, zero));
+        hit = _mm_and_ps(hit, _mm_cmplt_ps(t, closestFractions));
+        hit = _mm_and_ps(hit, _mm_cmpge_ps(u, zero));
+        hit = _mm_and_ps(hit, _mm_cmple_ps(u, one));
+        closestFractions = _mm_or_ps(_mm_and_ps(hit, t), _mm_andnot_ps(hit, closestFractions));
+    }
+    closest = horizontalMin(closestFractions);
+#endif
+
+    for (; circleIdx < circleCount; circleIdx++) {
+        closest = castRayCircle(ray, m_circleX[circleIdx], m_circleY[circleIdx], m_circleRadius[circleIdx], closest);
+    }
+    for (; edgeIdx < edgeCount; edgeIdx++) {
+        closest = castRayEdge(ray, m_edgeX[edgeIdx], m_edgeY[edgeIdx],
+                              m_edgeDeltaX[edgeIdx], m_edgeDeltaY[edgeIdx], closest);
+    }
+    return closest;
+}
@@ -0,0 +1,48 @@
+#ifndef RAY_TARGETS_H_
+#define RAY_TARGETS_H_
+
+#include <glm/glm.hpp>
+#include <vector>
+
+/**
+ * Circles and convex polygon edges packed as structure-of-arrays, which a ray can be
+ * tested against with SIMD (AVX2 or SSE2 depending on the build, otherwise scalar).
+ * Range sensors only ever hit circles and convex polygons, so this replaces a virtual
+ * Box2D RayCast call per fixture with one tight loop over the nearby shapes.
+ *
+ * The hits match b2CircleShape::RayCast and b2PolygonShape::RayCast: only rays that
+ * enter a shape from the outside count, so a ray starting inside a shape (e.g. the
+ * body the sensor is mounted on) doesn't hit it.
+ *
+ * The coordinates are whatever the caller uses (e.g. scaled physics coordinates).
+ */
+class RayTargets
+{
+public:
+    void clear();
+    void addCircle(const glm::vec2 &center, float radius);
+    /** Vertices in counter-clockwise order (like b2PolygonShape) */
+    void addPolygon(const glm::vec2 *vertices, unsigned int vertexCount);
+    /** A two-sided line segment (like b2EdgeShape) */
+    void addSegment(const glm::vec2 &start, const glm::vec2 &end);
+    bool isEmpty() const { return m_circleX.empty() && m_edgeX.empty(); }
+
+    /**
+     * \return the fraction along start->end of the closest hit, or 1.0 if there is no hit
+     */
+    float castRay(const glm::vec2 &start, const glm::vec2 &end) const;
+
+private:
+    /** An edge only counts when the ray crosses it from its right (outside) side */
+    void addEdge(const glm::vec2 &start, const glm::vec2 &end);
+
+    std::vector<float> m_circleX;
+    std::vector<float> m_circleY;
+    std::vector<float> m_circleRadius;
+    std::vector<float> m_edgeX;
+    std::vector<float> m_edgeY;
+    std::vector<float> m_edgeDeltaX;
+    std::vector<float> m_edgeDeltaY;
+};
+
+#endif /* RAY_TARGETS_H_ */
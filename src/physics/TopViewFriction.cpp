@@ -0,0 +1,52 @@
+#include "TopViewFriction.h"
+
+#include <box2d/box2d.h>
+#include <algorithm>
+#include <cassert>
+
+void TopViewFriction::addBody(Body *body)
+{
+    assert(body != nullptr && body->body != nullptr);
+    m_bodies.push_back(body);
+}
+
+void TopViewFriction::removeBody(Body *body)
+{
+    auto itr = std::find(m_bodies.begin(), m_bodies.end(), body);
+    if (itr != m_bodies.end()) {
+        /* Order doesn't matter */
+        *itr = m_bodies.back();
+        m_bodies.pop_back();
+    }
+}
+
+void TopViewFriction::apply(float stepTime)
+{
+    for (auto frictionBody : m_bodies) {
+        b2Body *body = frictionBody->body;
+        const float mass = body->GetMass();
+        const b2Vec2 appliedForce(frictionBody->appliedForceX, frictionBody->appliedForceY);
+        if (mass == 0.0f || frictionBody->maxForce == 0.0f || !body->IsAwake()) {
+            /* Static, frictionless or sleeping */
+            continue;
+        }
+
+        /* The velocity after the step if there were no friction */
+        const b2Vec2 velocity = body->GetLinearVelocity() + (stepTime / mass) * appliedForce;
+        b2Vec2 impulse = -mass * velocity;
+        const float maxImpulse = frictionBody->maxForce * stepTime;
+        const float impulseLength = impulse.Length();
+        if (impulseLength > maxImpulse) {
+            impulse *= maxImpulse / impulseLength;
+        }
+        body->ApplyLinearImpulseToCenter(impulse, false);
+    }
+}
+
+void TopViewFriction::clearForces()
+{
+    for (auto frictionBody : m_bodies) {
+        frictionBody->appliedForceX = 0.0f;
+        frictionBody->appliedForceY = 0.0f;
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef TOP_VIEW_FRICTION_H_
+#define TOP_VIEW_FRICTION_H_
+
+#include <vector>
+
+class b2Body;
+
+/**
+ * Ground friction for top view mode, applied directly to the bodies. The alternative is
+ * a b2FrictionJoint to a static ground body per body, which doubles the number of bodies
+ * and adds a joint per body for the solver.
+ *
+ * Before each physics step, every registered body gets the Coulomb friction impulse that
+ * brings it to rest, limited by its max friction force. The forces applied to the body
+ * (through Body2D::setForce) are included, so a body that isn't pushed harder than the
+ * friction limit stays still. Like the joint, only linear motion is affected (no torque).
+ *
+ * Unlike the joint, the friction is not solved together with the contacts and joints,
+ * which makes it slightly less accurate for bodies coupled by joints (e.g. wheels).
+ */
+class TopViewFriction
+{
+public:
+    /** Friction state of one body, owned by the body (Body2D) */
+    struct Body {
+        b2Body *body = nullptr;
+        /** Scaled (Box2D) units */
+        float maxForce = 0.0f;
+        /** Sum of the forces applied since the forces were last cleared (scaled units) */
+        float appliedForceX = 0.0f;
+        float appliedForceY = 0.0f;
+    };
+
+    void addBody(Body *body);
+    void removeBody(Body *body);
+    /** Applies the friction impulses, call it right before stepping the Box2D world */
+    void apply(float stepTime);
+    /** Forgets the applied forces, call it together with b2World::ClearForces */
+    void clearForces();
+
+private:
+    std::vector<Body *> m_bodies;
+};
+
+#endif /* TOP_VIEW_FRICTION_H_ */
@@ -0,0 +1,30 @@
+#ifndef VOLTAGE_LINES_H_
+#define VOLTAGE_LINES_H_
+
+#include <vector>
+#include <algorithm>
+
+/**
+ * The voltage lines (sensor outputs and motor inputs) of a physics world, which are
+ * saved together with the bodies in a snapshot (see PhysicsWorld::snapshot). Objects
+ * that own a voltage line add it on creation and remove it on destruction.
+ */
+class VoltageLines
+{
+public:
+    void add(float *voltageLine)
+    {
+        m_voltageLines.push_back(voltageLine);
+    }
+    void remove(float *voltageLine)
+    {
+        m_voltageLines.erase(std::remove(m_voltageLines.begin(), m_voltageLines.end(), voltageLine),
+                             m_voltageLines.end());
+    }
+    const std::vector<float *> &get() const { return m_voltageLines; }
+
+private:
+    std::vector<float *> m_voltageLines;
+};
+
+#endif /* VOLTAGE_LINES_H_ */
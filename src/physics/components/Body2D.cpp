@@ -43,9 +43,17 @@ private:
     b2Body *m_body = nullptr;
 };
 
-constexpr int totalVertexCount = 180;
-constexpr float anglePerVertex = 2 * glm::pi<float>() / totalVertexCount;
-constexpr int trapezoidVertexCount = 4;
+b2Filter toB2Filter(const Body2D::CollisionFilter &collisionFilter)
+{
+    b2Filter filter;
+    filter.categoryBits = collisionFilter.categoryBits;
+    filter.maskBits = collisionFilter.maskBits;
+    filter.groupIndex = collisionFilter.groupIndex;
+    return filter;
+}
+
+constexpr int ringLoopVertexCount = 180;
+constexpr float anglePerVertex = 2 * glm::pi<float>() / ringLoopVertexCount;
 }
 
 Body2D::Body2D(const PhysicsWorld &world, RectTransform *transform, const Body2D::Specification &spec) :
@@ -62,6 +70,7 @@ Body2D::Body2D(const PhysicsWorld &world, RectTransform *transform, const Body2D
 
     b2BodyDef bodyDef;
     bodyDef.type = spec.dynamic ? b2_dynamicBody : b2_staticBody;
+    bodyDef.bullet = spec.dynamic && world.getActiveSettings().bulletBodies;
     bodyDef.position = b2Vec2(scaledPosition.x, scaledPosition.y);
     bodyDef.angle = transform->rotation;
     m_body = m_world->CreateBody(&bodyDef);
@@ -72,12 +81,13 @@ Body2D::Body2D(const PhysicsWorld &world, RectTransform *transform, const Body2D
     fixtureDef.shape = &polygonShape;
     fixtureDef.isSensor = !spec.collision;
     fixtureDef.density = scaledDensity;
+    fixtureDef.filter = toB2Filter(spec.collisionFilter);
     m_body->CreateFixture(&fixtureDef);
 
     m_translator = std::make_unique<RectTransformTranslator>(transform, m_body);
 
     if (world.getGravityType() == PhysicsWorld::Gravity::TopView) {
-        addTopViewFriction(normalForce, spec.frictionCoefficient);
+        addTopViewFriction(world, normalForce, spec.frictionCoefficient);
     }
 }
 
@@ -95,6 +105,7 @@ Body2D::Body2D(const PhysicsWorld &world, const glm::vec2 &startPosition, float
 
     b2BodyDef bodyDef;
     bodyDef.type = spec.dynamic ? b2_dynamicBody : b2_staticBody;
+    bodyDef.bullet = spec.dynamic && world.getActiveSettings().bulletBodies;
     bodyDef.position = b2Vec2(scaledPosition.x, scaledPosition.y);
     bodyDef.angle = rotation;
     m_body = m_world->CreateBody(&bodyDef);
@@ -105,10 +116,11 @@ Body2D::Body2D(const PhysicsWorld &world, const glm::vec2 &startPosition, float
     fixtureDef.shape = &circleShape;
     fixtureDef.isSensor = !spec.collision;
     fixtureDef.density = scaledDensity;
+    fixtureDef.filter = toB2Filter(spec.collisionFilter);
     m_body->CreateFixture(&fixtureDef);
 
     if (world.getGravityType() == PhysicsWorld::Gravity::TopView) {
-        addTopViewFriction(normalForce, spec.frictionCoefficient);
+        addTopViewFriction(world, normalForce, spec.frictionCoefficient);
     }
 }
 
@@ -129,27 +141,50 @@ Body2D::Body2D(const PhysicsWorld &world, HollowCircleTransform *transform, cons
     const float scaledInnerRadius = PhysicsWorld::scaleLength(transform->innerRadius);
     const float scaledOuterRadius = PhysicsWorld::scaleLength(transform->outerRadius);
     const glm::vec2 scaledPosition = PhysicsWorld::scalePosition(transform->position);
+    m_ring = std::make_unique<AnalyticRing>(AnalyticRing{ transform->position, transform->innerRadius,
+                                                          transform->outerRadius });
 
     b2BodyDef bodyDef;
     bodyDef.type = b2_staticBody;
     bodyDef.position = b2Vec2(scaledPosition.x, scaledPosition.y);
-
     m_body = m_world->CreateBody(&bodyDef);
-    b2PolygonShape shape;
-    b2Vec2 trapezoidVertices[trapezoidVertexCount];
-    float angle=0;
-    for (int cornerIdx=0; cornerIdx < totalVertexCount; cornerIdx++) {
-        angle = cornerIdx * anglePerVertex;
-        trapezoidVertices[0].Set(scaledInnerRadius * cosf(angle), scaledInnerRadius * sinf(angle));
-        trapezoidVertices[1].Set(scaledOuterRadius * cosf(angle), scaledOuterRadius * sinf(angle));
-        angle += anglePerVertex;
-        trapezoidVertices[2].Set(scaledOuterRadius * cosf(angle), scaledOuterRadius * sinf(angle));
-        trapezoidVertices[3].Set(scaledInnerRadius * cosf(angle), scaledInnerRadius * sinf(angle));
-        shape.Set(trapezoidVertices, trapezoidVertexCount);
-        b2FixtureDef fixtureDef;
-        fixtureDef.shape = &shape;
-        fixtureDef.isSensor = !spec.collision;
-        m_body->CreateFixture(&fixtureDef);
+
+    /* A single sensor circle covering the ring puts it in the broadphase, whether a point
+     * is on the ring is then decided by the analytic ring (see LineDetector) */
+    b2CircleShape circleShape;
+    circleShape.m_radius = scaledOuterRadius;
+    b2FixtureDef fixtureDef;
+    fixtureDef.shape = &circleShape;
+    fixtureDef.isSensor = true;
+    fixtureDef.userData.pointer = reinterpret_cast<uintptr_t>(m_ring.get());
+    fixtureDef.filter = toB2Filter(spec.collisionFilter);
+    m_body->CreateFixture(&fixtureDef);
+
+    if (spec.collision) {
+        /* Collide with the inner and outer edge of the ring. Chains only collide on the
+         * right side of their edges, so the inner loop goes clockwise to face the center
+         * and the outer loop counter-clockwise to face outwards. */
+        const struct { float scaledRadius; float anglePerVertex; } loops[] = {
+            { scaledInnerRadius, -anglePerVertex },
+            { scaledOuterRadius, anglePerVertex }
+        };
+        for (const auto &loop : loops) {
+            b2Vec2 loopVertices[ringLoopVertexCount];
+            for (int vertexIdx = 0; vertexIdx < ringLoopVertexCount; vertexIdx++) {
+                const float angle = vertexIdx * loop.anglePerVertex;
+                loopVertices[vertexIdx].Set(loop.scaledRadius * cosf(angle), loop.scaledRadius * sinf(angle));
+            }
+            b2ChainShape chainShape;
+            chainShape.CreateLoop(loopVertices, ringLoopVertexCount);
+            b2FixtureDef chainFixtureDef;
+            chainFixtureDef.shape = &chainShape;
+            /* The category and mask of the spec (e.g. detectable) are for the sensor circle,
+             * the walls collide like any other body */
+            CollisionFilter wallFilter;
+            wallFilter.groupIndex = spec.collisionFilter.groupIndex;
+            chainFixtureDef.filter = toB2Filter(wallFilter);
+            m_body->CreateFixture(&chainFixtureDef);
+        }
     }
 
     /* Only static so no translation needed for now */
@@ -184,6 +219,7 @@ Body2D::Body2D(const PhysicsWorld &world, QuadTransform *transform, const Body2D
     fixtureDef.shape = &shape;
     /* Quad body doesn't support dynamic or collision yet */
     fixtureDef.isSensor = true;
+    fixtureDef.filter = toB2Filter(spec.collisionFilter);
     m_body->CreateFixture(&fixtureDef);
 
     /* Only static so no translation needed for now */
@@ -193,6 +229,9 @@ Body2D::Body2D(const PhysicsWorld &world, QuadTransform *transform, const Body2D
 
 Body2D::~Body2D()
 {
+    if (m_topViewFriction != nullptr) {
+        m_topViewFriction->removeBody(&m_topViewFrictionBody);
+    }
     m_world->DestroyBody(m_body);
     if (m_frictionBody != nullptr) {
         m_world->DestroyBody(m_frictionBody);
@@ -249,6 +288,9 @@ void Body2D::setForce(const glm::vec2 &vec, float magnitude)
 {
     const float scaledMagnitude = PhysicsWorld::scaleForce(magnitude);
     m_body->ApplyForce(scaledMagnitude * b2Vec2(vec.x, vec.y), m_body->GetWorldCenter(), true);
+    /* The friction must know what it's working against */
+    m_topViewFrictionBody.appliedForceX += scaledMagnitude * vec.x;
+    m_topViewFrictionBody.appliedForceY += scaledMagnitude * vec.y;
 }
 
 void Body2D::setLinearImpulse(const glm::vec2 &vec)
@@ -288,6 +330,11 @@ glm::vec2 Body2D::getForwardNormal() const
     return glm::vec2{ forwardNormal.x, forwardNormal.y };
 }
 
+const AnalyticRing *Body2D::getRing() const
+{
+    return m_ring.get();
+}
+
 float Body2D::getMass() const
 {
     assert(m_body);
@@ -303,13 +350,22 @@ void Body2D::setMass(float mass)
     m_body->SetMassData(&massData);
 
     /* Must also update top view friction */
-    if (m_topViewFrictionJoint != nullptr) {
+    if (m_topViewFrictionJoint != nullptr || m_topViewFriction != nullptr) {
         setFrictionCoefficient(m_topViewFrictionCoefficient);
     }
 }
 
-void Body2D::addTopViewFriction(float normalForce, float frictionCoefficient)
+void Body2D::addTopViewFriction(const PhysicsWorld &world, float normalForce, float frictionCoefficient)
 {
+    m_topViewFrictionCoefficient = frictionCoefficient;
+    if (world.getTopViewFrictionMode() == PhysicsWorld::TopViewFrictionMode::Integrator) {
+        m_topViewFrictionBody.body = m_body;
+        m_topViewFrictionBody.maxForce = normalForce * frictionCoefficient;
+        m_topViewFriction = world.getTopViewFriction();
+        m_topViewFriction->addBody(&m_topViewFrictionBody);
+        return;
+    }
+
     b2BodyDef frictionBodyDef;
     b2FixtureDef fixtureDef;
     fixtureDef.isSensor = true;
@@ -318,7 +374,6 @@ void Body2D::addTopViewFriction(float normalForce, float frictionCoefficient)
     jointDef.bodyA = m_frictionBody;
     jointDef.bodyB = m_body;
     jointDef.maxForce = normalForce * frictionCoefficient;
-    m_topViewFrictionCoefficient = frictionCoefficient;
 
     /* Don't use torque friction, it just causes weird physics behaviour */
     jointDef.maxTorque = 0.0f;
@@ -328,16 +383,14 @@ void Body2D::addTopViewFriction(float normalForce, float frictionCoefficient)
 
 void Body2D::setFrictionCoefficient(float frictionCoefficient)
 {
-    assert(m_topViewFrictionJoint != nullptr);
+    assert(m_topViewFrictionJoint != nullptr || m_topViewFriction != nullptr);
     assert(0.0f <= frictionCoefficient && frictionCoefficient <= 1.0f);
     float normalForce = PhysicsWorld::normalForce(getMass());
-    m_topViewFrictionJoint->SetMaxForce(normalForce * frictionCoefficient);
+    if (m_topViewFrictionJoint != nullptr) {
+        m_topViewFrictionJoint->SetMaxForce(normalForce * frictionCoefficient);
+    } else {
+        m_topViewFrictionBody.maxForce = normalForce * frictionCoefficient;
+    }
     m_topViewFrictionCoefficient = frictionCoefficient;
 }
 
-float Body2D::getTopViewFrictionForce(float stepTime) const
-{
-    const b2Vec2 reactionForce = m_topViewFrictionJoint->GetReactionForce(1.0f / stepTime);
-    return PhysicsWorld::unscaleForce(reactionForce.Length());
-}
-
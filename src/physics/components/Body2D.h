@@ -2,7 +2,10 @@
 #define BODY_2D_H_
 
 #include "PhysicsComponent.h"
+#include "TopViewFriction.h"
+#include "AnalyticRing.h"
 #include <vector>
+#include <cstdint>
 
 class b2Body;
 class b2Joint;
@@ -23,6 +26,28 @@ struct QuadCoords;
 class Body2D : public PhysicsComponent
 {
 public:
+    /**
+     * Decides which bodies make contacts with each other (see b2Filter). Two bodies only
+     * make contacts if each one's category is in the other's mask. Bodies with the same
+     * negative group never make contacts, e.g. the parts of a robot (see
+     * PhysicsWorld::createCollisionGroup).
+     */
+    struct CollisionFilter {
+        static constexpr uint16_t defaultCategory = 0x0001;
+        /** Bodies found by line detectors (see BodyId::Detectable) */
+        static constexpr uint16_t detectableCategory = 0x0002;
+        /** For detectable bodies, which are only found by line detectors and kept out of the contacts */
+        static CollisionFilter detectable()
+        {
+            CollisionFilter filter;
+            filter.categoryBits = detectableCategory;
+            filter.maskBits = 0;
+            return filter;
+        }
+        uint16_t categoryBits = defaultCategory;
+        uint16_t maskBits = 0xFFFF;
+        int16_t groupIndex = 0;
+    };
     struct Specification {
         Specification() {}
         Specification(bool dynamic, bool collision, float mass, float frictionCoefficient) :
@@ -36,12 +61,18 @@ public:
         float mass = 1.0f;
         /** This determines how easy it is to push the body (ONLY for top view) */
         float frictionCoefficient = 0.0f;
+        CollisionFilter collisionFilter;
     };
 
     Body2D(const PhysicsWorld &world, const glm::vec2 &startPosition, float rotation, float radius,
            const Body2D::Specification &spec);
     Body2D(const PhysicsWorld &world, CircleTransform *transform, const Specification &spec);
     Body2D(const PhysicsWorld &world, RectTransform *transform, const Specification &spec);
+    /**
+     * A static ring, which is represented by an AnalyticRing instead of polygons. Its fixture
+     * is a sensor circle with the AnalyticRing as fixture user data. With collision enabled,
+     * the inner and outer edge also get chain loops.
+     */
     Body2D(const PhysicsWorld &world, HollowCircleTransform *transform, const Specification &spec);
     Body2D(const PhysicsWorld &world, QuadTransform *transform, const Specification &spec);
     ~Body2D();
@@ -60,19 +91,23 @@ public:
     float getMass() const;
     void setMass(float mass);
     void setFrictionCoefficient(float frictionCoefficient);
+    /** Only set for ring bodies (HollowCircleTransform) */
+    const AnalyticRing *getRing() const;
 
 private:
     /**
-     * In top view gravity mode, the gravity is set to 0.
-     * We use b2FrictionJoint as a workaround for friction.
+     * In top view gravity mode, the gravity is set to 0. The friction is added by
+     * TopViewFriction, or a b2FrictionJoint as a workaround (see PhysicsWorld::TopViewFrictionMode).
      */
-    void addTopViewFriction(float normalForce, float frictionCoefficient);
-    float getTopViewFrictionForce(float stepTime) const;
+    void addTopViewFriction(const PhysicsWorld &world, float normalForce, float frictionCoefficient);
 
     float m_topViewFrictionCoefficient = 0.0f;
     b2FrictionJoint *m_topViewFrictionJoint = nullptr;
+    TopViewFriction *m_topViewFriction = nullptr;
+    TopViewFriction::Body m_topViewFrictionBody;
     b2Body *m_body = nullptr;
     b2Body *m_frictionBody = nullptr;
+    std::unique_ptr<AnalyticRing> m_ring;
 };
 
 #endif /* BODY_2D_H_ */
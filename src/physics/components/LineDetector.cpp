@@ -1,29 +1,71 @@
 #include "components/LineDetector.h"
-#include "components/Body2D.h"
 #include "components/Transforms.h"
+#include "components/Body2D.h"
+#include "Body2DUserData.h"
+#include "AnalyticRing.h"
+#include "FloorMap.h"
+#include "VoltageLines.h"
+
+#include <box2d/box2d.h>
 
 namespace {
     constexpr float drawRadiusUndetected = 0.001f;
     constexpr float drawRadiusDetected = 10 * drawRadiusUndetected;
+
+    /**
+     * Stops at the first detectable fixture that contains the point. Rings (see Body2D) are
+     * tested analytically.
+     */
+    class DetectableQueryCallback : public b2QueryCallback
+    {
+    public:
+        DetectableQueryCallback(const glm::vec2 &position, const b2Vec2 &point) :
+            position(position), point(point) {}
+
+        bool ReportFixture(b2Fixture *fixture) override
+        {
+            if (!(fixture->GetFilterData().categoryBits & Body2D::CollisionFilter::detectableCategory)) {
+                return true;
+            }
+            const b2BodyUserData &userData = fixture->GetBody()->GetUserData();
+            if (userData.pointer == 0) {
+                return true;
+            }
+            const Body2DUserData *body2DUserData = reinterpret_cast<Body2DUserData *>(userData.pointer);
+            if (body2DUserData->bodyId != BodyId::Detectable) {
+                return true;
+            }
+            const auto ring = reinterpret_cast<const AnalyticRing *>(fixture->GetUserData().pointer);
+            if (ring ? ring->contains(position) : fixture->TestPoint(point)) {
+                detected = true;
+                return false;
+            }
+            return true;
+        }
+
+        const glm::vec2 position;
+        const b2Vec2 point;
+        bool detected = false;
+    };
 }
 
 LineDetector::LineDetector(const PhysicsWorld &world, CircleTransform *transform, const glm::vec2 &startPosition) :
     PhysicsComponent(world),
+    m_physicsWorld(&world),
+    m_mount(startPosition),
     m_transform(transform)
 {
-    /* Represent as tiny body */
-    const Body2D::Specification bodySpec { true, false, 0.001f };
-    m_body2D = std::make_unique<Body2D>(world, startPosition, 0.0f, drawRadiusUndetected, bodySpec);
-    m_body2D->setUserData(&m_userData);
+    m_physicsWorld->getVoltageLines()->add(&m_detectVoltage);
 }
 
 LineDetector::~LineDetector()
 {
+    m_physicsWorld->getVoltageLines()->remove(&m_detectVoltage);
 }
 
-Body2D *LineDetector::getBody() const
+void LineDetector::attach(const Body2D *hostBody, const glm::vec2 &relativePosition)
 {
-    return m_body2D.get();
+    m_mount.attach(hostBody, relativePosition);
 }
 
 float *LineDetector::getVoltageLine()
@@ -31,13 +73,28 @@ float *LineDetector::getVoltageLine()
     return &m_detectVoltage;
 }
 
+bool LineDetector::isLineDetected(const glm::vec2 &position) const
+{
+    if (const FloorMap *floorMap = m_physicsWorld->getFloorMap()) {
+        return floorMap->isLineDetected(position);
+    }
+    const b2Vec2 point(PhysicsWorld::scalePosition(position.x), PhysicsWorld::scalePosition(position.y));
+    b2AABB pointBounds;
+    pointBounds.lowerBound = point;
+    pointBounds.upperBound = point;
+    DetectableQueryCallback callback(position, point);
+    m_world->QueryAABB(&callback, pointBounds);
+    return callback.detected;
+}
+
 void LineDetector::onFixedUpdate()
 {
-    const bool detected = m_userData.contactCount.load() > 0;
+    const glm::vec2 position = m_mount.getPosition();
+    const bool detected = isLineDetected(position);
     m_detectVoltage = detected ? 3.3f : 0.0f;
     const bool debugDraw = m_transform != nullptr;
     if (debugDraw) {
-        m_transform->position = m_body2D->getPosition();
+        m_transform->position = position;
         m_transform->radius = detected ? drawRadiusDetected : drawRadiusUndetected;
     }
 }
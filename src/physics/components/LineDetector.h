@@ -2,15 +2,16 @@
 #define LINE_DETECTOR_H_
 
 #include "PhysicsComponent.h"
-#include "Body2DUserData.h"
+#include "components/SensorMount.h"
 
 class Body2D;
-class b2Body;
 class CircleTransform;
 
 /**
  * A perfect line detector sensor, which detects physics bodies with BodyId set to
- * "Detectable" (see Body2DUserData).
+ * "Detectable" (see Body2DUserData). It's a point, which is tested against the
+ * fixtures below it every fixed update. If the physics world has a floor map
+ * (see FloorMap), the point is looked up in the map instead.
  */
 class LineDetector : public PhysicsComponent
 {
@@ -18,13 +19,16 @@ public:
     LineDetector(const PhysicsWorld &world, CircleTransform *transform, const glm::vec2 &startPosition);
     ~LineDetector();
     void onFixedUpdate() override;
-    Body2D *getBody() const;
+    /** Mounts the sensor on a host body, see SensorMount */
+    void attach(const Body2D *hostBody, const glm::vec2 &relativePosition);
     /** Retrieve a pointer to the voltage line where the value is > 0 when detected and 0 when not detected. */
     float *getVoltageLine();
 
 private:
-    std::unique_ptr<Body2D> m_body2D;
-    Body2DUserData m_userData = { 0, 0, BodyId::LineDetector };
+    bool isLineDetected(const glm::vec2 &position) const;
+
+    const PhysicsWorld * const m_physicsWorld;
+    SensorMount m_mount;
     CircleTransform * const m_transform = nullptr;
     float m_detectVoltage = 0.0f;
 };
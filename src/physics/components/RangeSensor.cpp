@@ -1,11 +1,73 @@
 #include "components/RangeSensor.h"
-#include "components/Body2D.h"
 #include "components/Transforms.h"
+#include "RangeSensorSystem.h"
+#include "VoltageLines.h"
+#include "RayTargets.h"
 
 #include <box2d/box2d.h>
+#include <algorithm>
 
 namespace {
     constexpr float debugDrawWidth = 0.001f;
+
+    /**
+     * Packs the shapes of the fixtures near the ray into RayTargets (in world coordinates),
+     * so they can be tested against the ray in one go instead of with a virtual RayCast
+     * call per fixture. Shapes other than circles and polygons (rare) are ray cast directly.
+     */
+    class RayTargetsQueryCallback : public b2QueryCallback
+    {
+    public:
+        RayTargetsQueryCallback(RayTargets &rayTargets, const b2RayCastInput &rayInput) :
+            rayTargets(rayTargets), rayInput(rayInput) {}
+
+        bool ReportFixture(b2Fixture *fixture) override
+        {
+            if (fixture->IsSensor()) {
+                /* Don't detect non-collidable objects */
+                return true;
+            }
+            const b2Transform &transform = fixture->GetBody()->GetTransform();
+            const b2Shape *shape = fixture->GetShape();
+            switch (shape->GetType()) {
+            case b2Shape::e_circle:
+            {
+                const auto circle = static_cast<const b2CircleShape *>(shape);
+                const b2Vec2 center = b2Mul(transform, circle->m_p);
+                rayTargets.addCircle({ center.x, center.y }, circle->m_radius);
+                break;
+            }
+            case b2Shape::e_polygon:
+            {
+                const auto polygon = static_cast<const b2PolygonShape *>(shape);
+                glm::vec2 vertices[b2_maxPolygonVertices];
+                for (int i = 0; i < polygon->m_count; i++) {
+                    const b2Vec2 vertex = b2Mul(transform, polygon->m_vertices[i]);
+                    vertices[i] = { vertex.x, vertex.y };
+                }
+                rayTargets.addPolygon(vertices, polygon->m_count);
+                break;
+            }
+            default:
+                for (int child = 0; child < shape->GetChildCount(); child++) {
+                    b2RayCastOutput rayOutput;
+                    if (fixture->RayCast(&rayOutput, rayInput, child) && rayOutput.fraction < closestFraction) {
+                        closestFraction = rayOutput.fraction;
+                    }
+                }
+                break;
+            }
+            return true;
+        }
+
+        RayTargets &rayTargets;
+        const b2RayCastInput &rayInput;
+        /** Closest hit among the shapes that were ray cast directly */
+        float closestFraction = 1.0f;
+    };
+
+    /* Reused by all sensors cast on the same thread to avoid allocating every step */
+    thread_local RayTargets t_rayTargets;
 }
 
 RangeSensor::RangeSensor(const PhysicsWorld &world, LineTransform *transform,
@@ -15,40 +77,47 @@ RangeSensor::RangeSensor(const PhysicsWorld &world, LineTransform *transform,
     m_relativeAngle(angle),
     m_minDistance(minDistance),
     m_maxDistance(maxDistance),
+    m_mount(startPosition),
+    m_rangeSensorSystem(world.getRangeSensorSystem()),
+    m_voltageLines(world.getVoltageLines()),
     m_detectedDistance(m_maxDistance)
 {
-    /* Create tiny body for attaching and keeping track of ray cast start position */
-    const Body2D::Specification bodySpec { true, false, 0.001f };
-    m_body2D = std::make_unique<Body2D>(world, startPosition, 0.0f, 0.0005f, bodySpec);
+    m_rangeSensorSystem->addSensor(this);
+    m_voltageLines->add(&m_distanceVoltage);
 }
 
 RangeSensor::~RangeSensor()
 {
+    m_rangeSensorSystem->removeSensor(this);
+    m_voltageLines->remove(&m_distanceVoltage);
 }
 
-Body2D *RangeSensor::getBody() const
+void RangeSensor::attach(const Body2D *hostBody, const glm::vec2 &relativePosition)
 {
-    return m_body2D.get();
+    m_mount.attach(hostBody, relativePosition);
 }
 
-void RangeSensor::onFixedUpdate()
+void RangeSensor::castRay()
 {
-    const float rayAngleEnd = m_relativeAngle - m_body2D->getRotation();
-    const glm::vec2 bodyPosition = m_body2D->getPosition();
+    const float rayAngleEnd = m_relativeAngle - m_mount.getRotation();
 
     /* Recalculate the casted ray */
-    const glm::vec2 rayStartPosition = bodyPosition;
-    const glm::vec2 rayEndPosition = rayStartPosition + glm::vec2{sinf(rayAngleEnd), cosf(rayAngleEnd)} * m_maxDistance;
-    updateDetectedDistance(rayStartPosition, rayEndPosition);
-    const glm::vec2 detectedEndPosition = rayStartPosition + glm::vec2{sinf(rayAngleEnd), cosf(rayAngleEnd)} * m_detectedDistance;
-    const bool debugDraw = m_lineTransform != nullptr;
+    m_rayStartPosition = m_mount.getPosition();
+    m_rayDirection = { sinf(rayAngleEnd), cosf(rayAngleEnd) };
+    const glm::vec2 rayEndPosition = m_rayStartPosition + m_rayDirection * m_maxDistance;
+    updateDetectedDistance(m_rayStartPosition, rayEndPosition);
+    updateVoltage();
+}
 
+void RangeSensor::onFixedUpdate()
+{
+    const bool debugDraw = m_lineTransform != nullptr;
     if (debugDraw) {
+        const glm::vec2 detectedEndPosition = m_rayStartPosition + m_rayDirection * m_detectedDistance;
         m_lineTransform->width = debugDrawWidth;
-        m_lineTransform->start = { rayStartPosition.x, rayStartPosition.y };
+        m_lineTransform->start = { m_rayStartPosition.x, m_rayStartPosition.y };
         m_lineTransform->end = { detectedEndPosition.x, detectedEndPosition.y };
     }
-    updateVoltage();
 }
 
 void RangeSensor::updateDetectedDistance(const glm::vec2 &start, const glm::vec2 &end)
@@ -56,31 +125,19 @@ void RangeSensor::updateDetectedDistance(const glm::vec2 &start, const glm::vec2
     const glm::vec2 scaledStart = PhysicsWorld::scalePosition(start);
     const glm::vec2 scaledEnd = PhysicsWorld::scalePosition(end);
     b2RayCastInput rayInput;
-    b2RayCastOutput rayOutput;
-    rayInput.p1.x = scaledStart.x;
-    rayInput.p1.y = scaledStart.y;
-    rayInput.p2.x = scaledEnd.x;
-    rayInput.p2.y = scaledEnd.y;
+    rayInput.p1 = b2Vec2(scaledStart.x, scaledStart.y);
+    rayInput.p2 = b2Vec2(scaledEnd.x, scaledEnd.y);
     rayInput.maxFraction = 1.0f;
 
-    float closestFraction = rayInput.maxFraction;
-    b2Vec2 intersectionNormal(0,0);
-    for (b2Body *b = m_world->GetBodyList(); b; b = b->GetNext()) {
-        if (b->GetFixtureList() && b->GetFixtureList()[0].IsSensor()) {
-            /* Don't detect non-collidable objects */
-            continue;
-        }
-        for (b2Fixture *f = b->GetFixtureList(); f; f = f->GetNext()) {
-            if (!f->RayCast(&rayOutput, rayInput, 1)) {
-                continue;
-            }
-            if (rayOutput.fraction < closestFraction) {
-                closestFraction = rayOutput.fraction;
-                intersectionNormal = rayOutput.normal;
-            }
-        }
-    }
+    /* Only the fixtures whose bounding boxes overlap the ray's in the broadphase tree are tested */
+    b2AABB rayBounds;
+    rayBounds.lowerBound = b2Vec2(std::min(scaledStart.x, scaledEnd.x), std::min(scaledStart.y, scaledEnd.y));
+    rayBounds.upperBound = b2Vec2(std::max(scaledStart.x, scaledEnd.x), std::max(scaledStart.y, scaledEnd.y));
+    t_rayTargets.clear();
+    RayTargetsQueryCallback callback(t_rayTargets, rayInput);
+    m_world->QueryAABB(&callback, rayBounds);
 
+    const float closestFraction = std::min(t_rayTargets.castRay(scaledStart, scaledEnd), callback.closestFraction);
     m_detectedDistance = closestFraction * m_maxDistance;
 }
 
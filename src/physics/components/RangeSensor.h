@@ -2,12 +2,18 @@
 #define RANGE_SENSOR_H_
 
 #include "PhysicsComponent.h"
+#include "components/SensorMount.h"
 
 class Body2D;
 class LineTransform;
+class RangeSensorSystem;
+class VoltageLines;
 
 /**
  * Implements a perfect range sensor. Min and max distance are adjustable.
+ *
+ * The ray is cast by the RangeSensorSystem of the physics world right after each
+ * physics step (possibly on another thread), onFixedUpdate only updates the debug draw.
  */
 class RangeSensor : public PhysicsComponent
 {
@@ -18,10 +24,16 @@ public:
     void onFixedUpdate() override;
     /** Retrieve distance in metrics */
     float getDistance() const;
-    Body2D *getBody() const;
+    /** Mounts the sensor on a host body, see SensorMount */
+    void attach(const Body2D *hostBody, const glm::vec2 &relativePosition);
     /** Retrieve a pointer to a voltage value which corresponds to the detected distance where max
      * distance is 3.3 V. */
     float *getVoltageLine();
+    /**
+     * Casts the ray from the current sensor position and updates the distance and voltage.
+     * Only reads the physics world, so it's safe to call for different sensors in parallel.
+     */
+    void castRay();
 
 private:
     void updateVoltage();
@@ -31,7 +43,11 @@ private:
     const float m_relativeAngle = 0.0f;
     const float m_minDistance = 0.0f;
     const float m_maxDistance = 0.0f;
-    std::unique_ptr<Body2D> m_body2D;
+    SensorMount m_mount;
+    RangeSensorSystem *const m_rangeSensorSystem = nullptr;
+    VoltageLines *const m_voltageLines = nullptr;
+    glm::vec2 m_rayStartPosition = { 0.0f, 0.0f };
+    glm::vec2 m_rayDirection = { 0.0f, 1.0f };
 
     float m_distanceVoltage = 0.0f;
     float m_detectedDistance = 0.0f;
@@ -0,0 +1,30 @@
+#include "components/SensorMount.h"
+#include "components/Body2D.h"
+
+#include <glm/gtx/rotate_vector.hpp>
+#include <cassert>
+
+SensorMount::SensorMount(const glm::vec2 &startPosition) :
+    m_position(startPosition)
+{
+}
+
+void SensorMount::attach(const Body2D *hostBody, const glm::vec2 &relativePosition)
+{
+    assert(hostBody != nullptr);
+    m_hostBody = hostBody;
+    m_position = relativePosition;
+}
+
+glm::vec2 SensorMount::getPosition() const
+{
+    if (m_hostBody == nullptr) {
+        return m_position;
+    }
+    return m_hostBody->getPosition() + glm::rotate(m_position, m_hostBody->getRotation());
+}
+
+float SensorMount::getRotation() const
+{
+    return m_hostBody ? m_hostBody->getRotation() : 0.0f;
+}
@@ -0,0 +1,29 @@
+#ifndef SENSOR_MOUNT_H_
+#define SENSOR_MOUNT_H_
+
+#include <glm/glm.hpp>
+
+class Body2D;
+
+/**
+ * The pose of a sensor that is mounted on a host body. The pose is calculated from the
+ * host body's transform when asked for, so the sensor doesn't need a Box2D body or joint
+ * of its own (which would add to the solver work and wobble).
+ *
+ * Until it's attached, the sensor stays at its start position.
+ */
+class SensorMount
+{
+public:
+    SensorMount(const glm::vec2 &startPosition);
+    /** \param relativePosition Position relative to the host body's center (in host body coordinates) */
+    void attach(const Body2D *hostBody, const glm::vec2 &relativePosition);
+    glm::vec2 getPosition() const;
+    float getRotation() const;
+
+private:
+    const Body2D *m_hostBody = nullptr;
+    glm::vec2 m_position = { 0.0f, 0.0f };
+};
+
+#endif /* SENSOR_MOUNT_H_ */
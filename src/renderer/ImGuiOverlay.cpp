@@ -1,4 +1,5 @@
 #include "ImGuiOverlay.h"
+#include "Profiler.h"
 #include <GLFW/glfw3.h>
 #include "backends/imgui_impl_glfw.h"
 #include "backends/imgui_impl_opengl3.h"
@@ -35,6 +36,7 @@ void ImGuiOverlay::newFrame()
 
 void ImGuiOverlay::render()
 {
+    Profiler::ScopedTimer timer(Profiler::Phase::ImGuiOverlayRender);
     ImGui::Render();
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 }
@@ -2,11 +2,15 @@
 #define SPRITE_ANIMATION_H_
 
 #include "TexCoords.h"
+#include <atomic>
 
 /**
  * Provides animation based on a spritesheet texture. It animates by showing a portion
  * of the spritesheet (a single sprite) at a time and changing the texture coordinates
  * based on the specified update frequency.
+ *
+ * The animation is advanced by the render thread, while the update frequency, direction
+ * and stop can be set from the simulation thread, so those are atomic.
  */
 class SpriteAnimation {
 public:
@@ -37,13 +41,13 @@ private:
     unsigned int m_spriteSheetHeight = 1;
     const unsigned int m_spriteCount = 1;
     unsigned int m_currentSpriteIndex = 1;
-    unsigned int m_framesBetweenUpdates = 10;
+    std::atomic<unsigned int> m_framesBetweenUpdates = 10;
     unsigned int m_framesSinceLastUpdate = 0;
     const float m_spriteWidth = 1.0f;
     const float m_spriteHeight = 1.0f;
     TexCoords m_texCoords;
-    Direction m_animationDirection = Direction::Forward;
-    bool m_stopped = false;
+    std::atomic<Direction> m_animationDirection = Direction::Forward;
+    std::atomic<bool> m_stopped = false;
 };
 
 #endif /* SPRITE_ANIMATION_H_ */
@@ -8,17 +8,29 @@
 #include <iostream>
 
 Texture::Texture(const std::string& textureName) :
-    m_filepath(AssetsHelper::getTexturePath(textureName))
+    m_textureName(textureName)
 {
+}
+
+Texture::~Texture()
+{
+    if (m_id != 0) {
+        GLCall(glDeleteTextures(1, &m_id));
+    }
+}
+
+void Texture::load() const
+{
+    const std::string filepath = AssetsHelper::getTexturePath(m_textureName);
     /* Flips texture upside down because OpenGl expects pixels to
        start at the bottom left */
     stbi_set_flip_vertically_on_load(1);
     /* 4 channels since RBGA */
-    m_localBuffer = stbi_load(m_filepath.c_str(), &m_width, &m_height, &m_bpp, 4);
+    unsigned char *localBuffer = stbi_load(filepath.c_str(), &m_width, &m_height, &m_bpp, 4);
 
-    if (m_localBuffer == nullptr) {
-        std::cout << "Could not find texture: " << m_filepath << std::endl;
-        assert(m_localBuffer != nullptr);
+    if (localBuffer == nullptr) {
+        std::cout << "Could not find texture: " << filepath << std::endl;
+        assert(localBuffer != nullptr);
     }
 
     GLCall(glGenTextures(1, &m_id));
@@ -34,21 +46,19 @@ Texture::Texture(const std::string& textureName) :
     /* Send the texture to OpenGl (allocate space on GPU)
      * First format is how OpenGL stores it (GL_RGBA8)
      * Second format is the format of the data we supply (GL_RGBA) */
-    GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_width, m_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, m_localBuffer));
+    GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_width, m_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, localBuffer));
     unbind();
 
-    if (m_localBuffer) {
-        stbi_image_free(m_localBuffer);
+    if (localBuffer) {
+        stbi_image_free(localBuffer);
     }
 }
 
-Texture::~Texture()
-{
-    GLCall(glDeleteTextures(1, &m_id));
-}
-
 void Texture::bind(unsigned int slot) const
 {
+    if (m_id == 0) {
+        load();
+    }
     /* Select which texture slot to use */
     GLCall(glActiveTexture(GL_TEXTURE0 + slot));
     /* Bind texture to that slot */
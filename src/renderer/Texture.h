@@ -5,6 +5,9 @@
 /**
  * Loads a texture (image file) from a given path.
  * It depends on stb_image.
+ *
+ * The image is loaded and uploaded to the GPU the first time the texture is bound,
+ * so textures can be created without an OpenGL context (see HeadlessRunner).
  */
 class Texture
 {
@@ -15,16 +18,18 @@ public:
     void bind(unsigned int slot = 0) const;
     void unbind() const;
 
+    /** Zero until the texture has been bound once */
     inline int getWidth() const { return m_width; }
     inline int getHeight() const { return m_height; }
 
 private:
-    unsigned int m_id = 0;
-    std::string m_filepath = nullptr;
-    unsigned char* m_localBuffer = nullptr;
-    int m_width = 0;
-    int m_height = 0;
-    int m_bpp = 0;
+    void load() const;
+
+    mutable unsigned int m_id = 0;
+    const std::string m_textureName;
+    mutable int m_width = 0;
+    mutable int m_height = 0;
+    mutable int m_bpp = 0;
 
 };
 #endif /* TEXTURE_H_ */
@@ -13,21 +13,38 @@
  * It can't be used directly in a Scene, instead it must be assigned to
  * a Scene object to be updated each simulation iteration.
  */
-class CircleComponent : public RenderableComponent
+struct CircleRenderState {
+    glm::vec2 position;
+    float radius = 0.0f;
+    bool enabled = true;
+};
+
+class CircleComponent : public InterpolatedRenderableComponent<CircleRenderState>
 {
 public:
     CircleComponent(const CircleTransform *transform, const glm::vec4& color) :
         m_transform(transform), m_color(color) {
         assert(transform != nullptr);
+        initSnapshots();
     }
 
-    void onFixedUpdate() override {
-        if (m_enabled == false) {
+private:
+    CircleRenderState getState() const override {
+        return { m_transform->position, m_transform->radius, m_enabled };
+    }
+    CircleRenderState interpolate(const CircleRenderState &previous, const CircleRenderState &current,
+                                  float alpha) const override {
+        return { glm::mix(previous.position, current.position, alpha),
+                 glm::mix(previous.radius, current.radius, alpha),
+                 current.enabled };
+    }
+    void draw(const CircleRenderState &state) override {
+        if (state.enabled == false) {
             return;
         }
-        Renderer::drawCircle(m_transform->position, m_transform->radius, m_color);
+        Renderer::drawCircle(state.position, state.radius, m_color);
     }
-private:
+
     const CircleTransform *const m_transform = nullptr;
     glm::vec4 m_color;
 };
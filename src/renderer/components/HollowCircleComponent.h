@@ -13,22 +13,39 @@
  * It can't be used directly in a Scene, instead it must be assigned to
  * a Scene object to be updated each simulation iteration.
  */
-class HollowCircleComponent : public RenderableComponent
+struct HollowCircleRenderState {
+    glm::vec2 position;
+    float innerRadius = 0.0f;
+    float outerRadius = 0.0f;
+    bool enabled = true;
+};
+
+class HollowCircleComponent : public InterpolatedRenderableComponent<HollowCircleRenderState>
 {
 public:
     HollowCircleComponent(const HollowCircleTransform *transform, const glm::vec4 &fillColor, const glm::vec4 &borderColor) :
         m_transform(transform), m_fillColor(fillColor), m_borderColor(borderColor) {
         assert(transform != nullptr);
+        initSnapshots();
     }
 
-    void onFixedUpdate() override {
-        if (m_enabled == false) {
+private:
+    HollowCircleRenderState getState() const override {
+        return { m_transform->position, m_transform->innerRadius, m_transform->outerRadius, m_enabled };
+    }
+    HollowCircleRenderState interpolate(const HollowCircleRenderState &previous, const HollowCircleRenderState &current,
+                                        float alpha) const override {
+        return { glm::mix(previous.position, current.position, alpha),
+                 current.innerRadius, current.outerRadius, current.enabled };
+    }
+    void draw(const HollowCircleRenderState &state) override {
+        if (state.enabled == false) {
             return;
         }
-        Renderer::drawCircle(m_transform->position, m_transform->outerRadius, m_borderColor);
-        Renderer::drawCircle(m_transform->position, m_transform->innerRadius, m_fillColor);
+        Renderer::drawCircle(state.position, state.outerRadius, m_borderColor);
+        Renderer::drawCircle(state.position, state.innerRadius, m_fillColor);
     }
-private:
+
     const HollowCircleTransform *const m_transform = nullptr;
     const glm::vec4 m_fillColor;
     const glm::vec4 m_borderColor;
@@ -13,23 +13,40 @@
  * It can't used directly in a Scene, instead it must be assigned to
  * a Scene object to be updated each simulation iteration.
  */
-class LineComponent : public RenderableComponent
+struct LineRenderState {
+    glm::vec2 start;
+    glm::vec2 end;
+    float width = 0.0f;
+    bool enabled = true;
+};
+
+class LineComponent : public InterpolatedRenderableComponent<LineRenderState>
 {
 public:
     LineComponent(const LineTransform *transform, const glm::vec4& color) :
         m_transform(transform),
-        m_color(color) {}
-    /**
-     * Called every simulation iteration (if assigned to a Scene Object).
-     */
-    void onFixedUpdate() override {
-        if (m_enabled == false) {
-            return;
-        }
+        m_color(color) {
         assert(m_transform != nullptr);
-        Renderer::drawLine(m_transform->start, m_transform->end, m_transform->width, m_color);
+        initSnapshots();
     }
+
 private:
+    LineRenderState getState() const override {
+        return { m_transform->start, m_transform->end, m_transform->width, m_enabled };
+    }
+    LineRenderState interpolate(const LineRenderState &previous, const LineRenderState &current,
+                                float alpha) const override {
+        return { glm::mix(previous.start, current.start, alpha),
+                 glm::mix(previous.end, current.end, alpha),
+                 current.width, current.enabled };
+    }
+    void draw(const LineRenderState &state) override {
+        if (state.enabled == false) {
+            return;
+        }
+        Renderer::drawLine(state.start, state.end, state.width, m_color);
+    }
+
     const LineTransform *const m_transform = nullptr;
     glm::vec4 m_color;
 };
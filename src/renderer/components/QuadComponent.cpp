@@ -7,15 +7,29 @@ QuadComponent::QuadComponent(const QuadTransform *transform, const glm::vec4 &co
     m_color(color)
 {
     assert(transform != nullptr);
+    initSnapshots();
 }
 
 QuadComponent::~QuadComponent()
 {
 }
 
-void QuadComponent::onFixedUpdate()
+QuadRenderState QuadComponent::getState() const
 {
-    if (m_enabled == false) {
+    return { m_enabled };
+}
+
+QuadRenderState QuadComponent::interpolate(const QuadRenderState &previous, const QuadRenderState &current,
+                                           float alpha) const
+{
+    (void)previous;
+    (void)alpha;
+    return current;
+}
+
+void QuadComponent::draw(const QuadRenderState &state)
+{
+    if (state.enabled == false) {
         return;
     }
 
@@ -14,14 +14,23 @@ class QuadTransform;
  * It can't be used directly in a Scene, instead it must be assigned to
  * a Scene object to be updated each simulation iteration.
  */
-class QuadComponent : public RenderableComponent
+/* The quad coordinates are constant, so only the enabled state is snapshotted */
+struct QuadRenderState {
+    bool enabled = true;
+};
+
+class QuadComponent : public InterpolatedRenderableComponent<QuadRenderState>
 {
 public:
     QuadComponent(const QuadTransform *transform, const glm::vec4 &color);
     ~QuadComponent();
 
-    void onFixedUpdate() override;
 private:
+    QuadRenderState getState() const override;
+    QuadRenderState interpolate(const QuadRenderState &previous, const QuadRenderState &current,
+                                float alpha) const override;
+    void draw(const QuadRenderState &state) override;
+
     const QuadTransform *const m_transform = nullptr;
     glm::vec4 m_color;
 };
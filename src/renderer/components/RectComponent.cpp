@@ -9,6 +9,7 @@ RectComponent::RectComponent(const RectTransform *transform, const glm::vec4& co
     m_quadTransform(transform),
     m_color(color)
 {
+    initSnapshots();
 }
 
 RectComponent::RectComponent(const RectTransform *transform, const std::string &textureName, SpriteAnimation *spriteAnimation) :
@@ -17,6 +18,7 @@ RectComponent::RectComponent(const RectTransform *transform, const std::string &
     m_texCoords(std::make_unique<TexCoords>()),
     m_spriteAnimation(spriteAnimation)
 {
+    initSnapshots();
 }
 
 RectComponent::RectComponent(const CircleTransform *transform, const std::string &textureName, SpriteAnimation *spriteAnimation) :
@@ -25,15 +27,43 @@ RectComponent::RectComponent(const CircleTransform *transform, const std::string
     m_texCoords(std::make_unique<TexCoords>()),
     m_spriteAnimation(spriteAnimation)
 {
+    initSnapshots();
 }
 
 RectComponent::~RectComponent()
 {
 }
 
-void RectComponent::onFixedUpdate()
+RectRenderState RectComponent::getState() const
 {
-    if (m_enabled == false) {
+    RectRenderState state;
+    if (m_quadTransform != nullptr) {
+        state.size = m_quadTransform->size;
+        state.position = m_quadTransform->position;
+        state.rotation = m_quadTransform->rotation;
+    } else if (m_circleTransform != nullptr) {
+        state.size = glm::vec2{ 2 * m_circleTransform->radius, 2 * m_circleTransform->radius };
+        state.position = m_circleTransform->position;
+        state.rotation = m_circleTransform->rotation;
+    } else {
+        assert(0);
+    }
+    state.enabled = m_enabled;
+    return state;
+}
+
+RectRenderState RectComponent::interpolate(const RectRenderState &previous, const RectRenderState &current,
+                                           float alpha) const
+{
+    return { glm::mix(previous.position, current.position, alpha),
+             current.size,
+             glm::mix(previous.rotation, current.rotation, alpha),
+             current.enabled };
+}
+
+void RectComponent::draw(const RectRenderState &state)
+{
+    if (state.enabled == false) {
         return;
     }
 
@@ -42,24 +72,9 @@ void RectComponent::onFixedUpdate()
         m_spriteAnimation->computeTexCoords(*m_texCoords);
     }
 
-    glm::vec2 size;
-    glm::vec2 position;
-    float rotation = 0.0f;
-    if (m_quadTransform != nullptr) {
-        size = m_quadTransform->size;
-        position = m_quadTransform->position;
-        rotation = m_quadTransform->rotation;
-    } else if (m_circleTransform != nullptr) {
-        size = glm::vec2{ 2 * m_circleTransform->radius, 2 * m_circleTransform->radius };
-        position = m_circleTransform->position;
-        rotation = m_circleTransform->rotation;
-    } else {
-        assert(0);
-    }
-
     if (m_texture) {
-        Renderer::drawRect(position, size, rotation, *m_texture.get(), m_texCoords.get());
+        Renderer::drawRect(state.position, state.size, state.rotation, *m_texture.get(), m_texCoords.get());
     } else {
-        Renderer::drawRect(position, size, rotation, m_color);
+        Renderer::drawRect(state.position, state.size, state.rotation, m_color);
     }
 }
@@ -19,7 +19,14 @@ class CircleTransform;
  * It can't be used directly in a Scene, instead it must be assigned to
  * a Scene object to be updated each simulation iteration.
  */
-class RectComponent : public RenderableComponent
+struct RectRenderState {
+    glm::vec2 position;
+    glm::vec2 size;
+    float rotation = 0.0f;
+    bool enabled = true;
+};
+
+class RectComponent : public InterpolatedRenderableComponent<RectRenderState>
 {
 public:
     RectComponent(const RectTransform *transform, const glm::vec4& color);
@@ -27,8 +34,12 @@ public:
     RectComponent(const CircleTransform *transform, const std::string &textureName, SpriteAnimation *spriteAnimation = nullptr);
     ~RectComponent();
 
-    void onFixedUpdate() override;
 private:
+    RectRenderState getState() const override;
+    RectRenderState interpolate(const RectRenderState &previous, const RectRenderState &current,
+                                float alpha) const override;
+    void draw(const RectRenderState &state) override;
+
     const RectTransform *const m_quadTransform = nullptr;
     const CircleTransform *const m_circleTransform = nullptr;
     glm::vec4 m_color;
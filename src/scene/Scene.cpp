@@ -1,6 +1,8 @@
 #include "Scene.h"
 #include "SceneObject.h"
-#include "ImGuiMenu.h"
+#include "ControllerScheduler.h"
+#include "Profiler.h"
+#include "Tracer.h"
 
 Scene::Scene(std::string description) :
     m_description(description)
@@ -24,6 +26,14 @@ PhysicsWorld *Scene::getPhysicsWorld() const
     return m_physicsWorld.get();
 }
 
+ControllerScheduler *Scene::getControllerScheduler()
+{
+    if (!m_controllerScheduler) {
+        m_controllerScheduler = std::make_unique<ControllerScheduler>();
+    }
+    return m_controllerScheduler.get();
+}
+
 void Scene::onKeyEvent(const Event::Key &keyEvent)
 {
     for (auto obj : m_objects) {
@@ -31,10 +41,22 @@ void Scene::onKeyEvent(const Event::Key &keyEvent)
     }
 }
 
+void Scene::step(float stepTime)
+{
+    Tracer::ScopedSpan span("Scene::step");
+    updatePhysics(stepTime);
+    m_simulatedSeconds += stepTime;
+    m_stepCount++;
+    onFixedUpdate();
+    updateControllers(stepTime);
+    sceneObjectsOnFixedUpdate();
+}
+
 void Scene::updatePhysics(float stepTime)
 {
     if (m_physicsWorld) {
         m_physicsWorld->step(stepTime);
+        Profiler::ScopedTimer timer(Profiler::Phase::UpdatePhysics);
         for (auto obj : m_objects) {
             obj->updatePhysics();
         }
@@ -43,26 +65,38 @@ void Scene::updatePhysics(float stepTime)
 
 void Scene::updateControllers(float stepTime)
 {
+    Profiler::ScopedTimer timer(Profiler::Phase::UpdateControllers);
     for (auto obj : m_objects) {
         obj->updateController(stepTime);
     }
+    if (m_controllerScheduler) {
+        m_controllerScheduler->step(stepTime);
+    }
 }
 
 void Scene::sceneObjectsOnFixedUpdate()
 {
+    Profiler::ScopedTimer timer(Profiler::Phase::SceneObjectsOnFixedUpdate);
     for (auto obj : m_objects) {
         obj->onFixedUpdate();
     }
 }
 
-void Scene::render()
+void Scene::storePreviousRenderState()
 {
-    for (auto menu : m_menus) {
-        menu->render();
+    for (auto obj : m_objects) {
+        obj->storePreviousRenderState();
     }
+}
+
+void Scene::storeSnapshot(float alpha, float alphaPerSecond)
+{
+    const unsigned int slot = m_snapshotIndex.getWriteSlot();
     for (auto obj : m_objects) {
-        obj->updateRenderable();
+        obj->storeRenderableSnapshot(slot);
     }
+    m_snapshotTimings[slot] = { std::chrono::steady_clock::now(), alpha, alphaPerSecond };
+    m_snapshotIndex.publish();
 }
 
 void Scene::addObject(SceneObject *sceneObject)
@@ -102,3 +136,8 @@ unsigned int Scene::getMillisecondsSinceStart() const
     const auto timeNow = std::chrono::system_clock::now();
     return std::chrono::duration<double, std::milli>(timeNow - m_startTime).count();
 }
+
+unsigned int Scene::getSimulatedMilliseconds() const
+{
+    return static_cast<unsigned int>(m_simulatedSeconds * 1000.0);
+}
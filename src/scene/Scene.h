@@ -3,18 +3,26 @@
 
 #include "Event.h"
 #include "PhysicsWorld.h"
+#include "TripleBufferIndex.h"
 #include <vector>
 #include <memory>
 #include <string>
 #include <chrono>
+#include <array>
 
 class SceneObject;
 class ImGuiMenu;
+class ControllerScheduler;
 
 /**
  * Base class for scenes. All scenes must inherit this class. A Scene provides the stage
  * for the simulation and has a PhysicsWorld and a list of SceneObject. Only one Scene
  * can be active at a time.
+ *
+ * When Application runs the simulation on its own thread, the render thread draws
+ * published snapshots without locking (see storeSnapshot). Scene objects must then only
+ * be added and removed from the scene constructor, menu callbacks or key events (render
+ * thread), not from fixed updates (simulation thread).
  */
 class Scene
 {
@@ -22,16 +30,44 @@ public:
     Scene(std::string description);
     /**
     * \param physicsStepTime Determines how many times per second the physics and logic are updated.
-    * Note, to avoid jittery behaviour, make this at least twice as large as the rendering rate
-    * (monitor's refresh rate).
+    * The rendering interpolates between steps, so it can be lower than the rendering rate.
     */
     Scene(std::string description, PhysicsWorld::Gravity gravity, float physicsStepTime = 0.001f);
     virtual ~Scene();
     PhysicsWorld *getPhysicsWorld() const;
+    /**
+     * Created on first use. Runs the scheduled microcontrollers after the controllers of
+     * the scene objects are updated, see Microcontroller::setScheduler.
+     */
+    ControllerScheduler *getControllerScheduler();
+    /**
+     * Advances the scene one fixed step: physics, then scene logic, controllers and
+     * scene objects. This is what both Application and HeadlessRunner call per step.
+     */
+    void step(float stepTime);
     void updatePhysics(float stepTime);
     void updateControllers(float stepTime);
     void sceneObjectsOnFixedUpdate();
+    /** Renders menus and the live state of all scene objects (single-threaded) */
     void render();
+    void renderMenus();
+    /** Remembers the render state of all scene objects, call it before each step */
+    void storePreviousRenderState();
+    /**
+     * Copies the render state of all scene objects into a snapshot and publishes it
+     * to the render thread. Called from the simulation thread after stepping.
+     *
+     * \param alpha How far simulated time has come from the latest step towards the next
+     * (leftover accumulator / step time).
+     * \param alphaPerSecond How fast alpha grows per wall-clock second, lets the render
+     * thread advance alpha until the next snapshot arrives. Zero to keep it constant.
+     */
+    void storeSnapshot(float alpha, float alphaPerSecond);
+    /**
+     * Renders the latest published snapshot, interpolated between the state before and
+     * after the latest step. Called from the render thread, lock-free.
+     */
+    void renderSnapshot();
     void onKeyEvent(const Event::Key &keyEvent);
     void addObject(SceneObject *sceneObject);
     void removeObject(SceneObject *sceneObject);
@@ -40,6 +76,14 @@ public:
     std::string getDescription() const { return m_description; }
     unsigned int getSecondsSinceStart() const;
     unsigned int getMillisecondsSinceStart() const;
+    /**
+     * Simulated time, i.e. the sum of all step times taken so far. Unlike the wall-clock
+     * getters above, this does not depend on how fast the scene is stepped. Use it for
+     * anything that should behave the same when running faster than real time.
+     */
+    double getSimulatedSeconds() const { return m_simulatedSeconds; }
+    unsigned int getSimulatedMilliseconds() const;
+    unsigned int getStepCount() const { return m_stepCount; }
     float getPhysicsStepTime() const { return m_physicsStepTime; }
 
 protected:
@@ -48,9 +92,19 @@ protected:
 private:
     std::vector<SceneObject *> m_objects;
     std::vector<ImGuiMenu *> m_menus;
+    std::unique_ptr<ControllerScheduler> m_controllerScheduler;
+    struct SnapshotTiming {
+        std::chrono::time_point<std::chrono::steady_clock> publishTime;
+        float alpha = 1.0f;
+        float alphaPerSecond = 0.0f;
+    };
+    TripleBufferIndex m_snapshotIndex;
+    std::array<SnapshotTiming, TripleBufferIndex::slotCount> m_snapshotTimings;
     std::string m_description;
     float m_physicsStepTime = 0.001f;
     const std::chrono::time_point<std::chrono::system_clock> m_startTime;
+    double m_simulatedSeconds = 0.0;
+    unsigned int m_stepCount = 0;
 };
 
 #endif /* SCENE_H_ */
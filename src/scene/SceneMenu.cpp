@@ -2,6 +2,17 @@
 #include "ImGuiOverlay.h"
 #include "Camera.h"
 #include "Application.h"
+#include "Profiler.h"
+
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+
+namespace {
+    const float minTimeScale = 0.1f;
+    const float maxTimeScale = 10.0f;
+    const std::string profilerCsvFilename = "bots2d_profile.csv";
+}
 
 SceneMenu::SceneMenu(Scene*& scene) :
     m_currentScene(scene)
@@ -10,6 +21,7 @@ SceneMenu::SceneMenu(Scene*& scene) :
 
 SceneMenu::~SceneMenu()
 {
+    Profiler::setEnabled(false);
     if (m_currentScene) {
         delete m_currentScene;
     }
@@ -30,6 +42,37 @@ void SceneMenu::setWarningMessage(std::string message)
     m_warningMessage = message;
 }
 
+void SceneMenu::setRealTimeFactor(float realTimeFactor)
+{
+    m_realTimeFactor = realTimeFactor;
+}
+
+void SceneMenu::setTimeScale(float timeScale)
+{
+    m_timeScale = std::clamp(timeScale, minTimeScale, maxTimeScale);
+}
+
+void SceneMenu::setAsFastAsPossible(bool enabled)
+{
+    m_asFastAsPossible = enabled;
+}
+
+void SceneMenu::setOverloadPolicy(StepTimer::OverloadPolicy policy)
+{
+    m_coarserStepWhenOverloaded = (policy == StepTimer::OverloadPolicy::CoarserStep);
+}
+
+StepTimer::OverloadPolicy SceneMenu::getOverloadPolicy() const
+{
+    return m_coarserStepWhenOverloaded ? StepTimer::OverloadPolicy::CoarserStep :
+                                         StepTimer::OverloadPolicy::SlowDown;
+}
+
+void SceneMenu::setOverloadStats(const StepTimer::OverloadStats &overloadStats)
+{
+    m_overloadStats = overloadStats;
+}
+
 void SceneMenu::setCurrentScene(std::string sceneName)
 {
     for (auto &scene : m_scenes) {
@@ -42,7 +85,7 @@ void SceneMenu::setCurrentScene(std::string sceneName)
 
 void SceneMenu::render()
 {
-    ImGuiOverlay::begin("Scene menu", 15.0f, 15.0f, 230.0f, 450.0f);
+    ImGuiOverlay::begin("Scene menu", 15.0f, 15.0f, 230.0f, 600.0f);
     for (auto& scene : m_scenes)
     {
         if (ImGuiOverlay::button(scene.first.c_str())) {
@@ -66,6 +109,36 @@ void SceneMenu::render()
     } else {
         ImGuiOverlay::text("Physics step rate: ");
     }
+    std::stringstream realTimeFactorStream;
+    realTimeFactorStream << std::fixed << std::setprecision(2) << m_realTimeFactor;
+    ImGuiOverlay::text("Real-time factor: " + realTimeFactorStream.str() + "x");
+    ImGuiOverlay::sliderFloat("Time scale", &m_timeScale, minTimeScale, maxTimeScale);
+    m_timeScale = std::clamp(m_timeScale, minTimeScale, maxTimeScale);
+    ImGuiOverlay::checkbox("As fast as possible", &m_asFastAsPossible);
+    ImGuiOverlay::checkbox("Coarser steps when overloaded", &m_coarserStepWhenOverloaded);
+    std::stringstream droppedStream;
+    droppedStream << std::fixed << std::setprecision(2) << m_overloadStats.droppedSeconds;
+    ImGuiOverlay::text("Overloaded frames: " + std::to_string(m_overloadStats.overloadedFrames) +
+                       " (clamped " + std::to_string(m_overloadStats.clampedFrames) + ")");
+    ImGuiOverlay::text("Slowed down by: " + droppedStream.str() + " s");
+    ImGuiOverlay::text("Coarse steps: " + std::to_string(m_overloadStats.coarseSteps) +
+                       " (x" + std::to_string(m_overloadStats.stepMultiplier) + ")");
+    const bool profilerWasEnabled = m_profilerEnabled;
+    ImGuiOverlay::checkbox("Show profiler", &m_profilerEnabled);
+    if (m_profilerEnabled != profilerWasEnabled) {
+        Profiler::reset();
+        Profiler::setEnabled(m_profilerEnabled);
+    }
+    /* Less accurate but faster physics, see PhysicsWorld::Settings */
+    PhysicsWorld *physicsWorld = m_currentScene ? m_currentScene->getPhysicsWorld() : nullptr;
+    if (physicsWorld != nullptr) {
+        bool benchmarkEnabled = physicsWorld->isBenchmarkEnabled();
+        ImGuiOverlay::checkbox("Benchmark physics settings", &benchmarkEnabled);
+        if (benchmarkEnabled != physicsWorld->isBenchmarkEnabled()) {
+            physicsWorld->setBenchmarkEnabled(benchmarkEnabled);
+        }
+        ImGuiOverlay::checkbox("Show physics stats", &m_physicsStatsEnabled);
+    }
     ImGuiOverlay::text("");
     ImGuiOverlay::text("Move camera up     <w>");
     ImGuiOverlay::text("Move camera left   <a>");
@@ -74,4 +147,67 @@ void SceneMenu::render()
     ImGuiOverlay::text("Zoom camera        <Scroll>");
     ImGuiOverlay::text("Reset camera       <r>");
     ImGuiOverlay::end();
+
+    if (m_profilerEnabled) {
+        renderProfiler();
+    }
+    if (m_physicsStatsEnabled && physicsWorld != nullptr) {
+        renderPhysicsStats(*physicsWorld);
+    }
+}
+
+/**
+ * Shows the rolling p50/p99/max duration of each profiled phase, see Profiler.
+ */
+void SceneMenu::renderProfiler()
+{
+    ImGuiOverlay::begin("Profiler", 260.0f, 15.0f, 330.0f, 220.0f);
+    ImGuiOverlay::text("Phase: p50 / p99 / max (us)");
+    for (unsigned int i = 0; i < static_cast<unsigned int>(Profiler::Phase::Count); i++) {
+        const Profiler::Phase phase = static_cast<Profiler::Phase>(i);
+        const Profiler::PhaseStats stats = Profiler::getStats(phase);
+        std::stringstream statsStream;
+        statsStream << std::fixed << std::setprecision(1) << stats.p50 << " / "
+                    << stats.p99 << " / " << stats.max;
+        ImGuiOverlay::text(Profiler::getPhaseName(phase) + ": " + statsStream.str());
+    }
+    if (ImGuiOverlay::button("Export CSV")) {
+        m_profilerMessage = Profiler::exportCsv(profilerCsvFilename) ?
+                            "Exported to " + profilerCsvFilename :
+                            "Failed to write " + profilerCsvFilename;
+    }
+    if (!m_profilerMessage.empty()) {
+        ImGuiOverlay::text(m_profilerMessage);
+    }
+    ImGuiOverlay::end();
+}
+
+/**
+ * Shows the rolling average of where the Box2D step time goes, see PhysicsWorld::StepStats.
+ */
+void SceneMenu::renderPhysicsStats(const PhysicsWorld &physicsWorld)
+{
+    const PhysicsWorld::StepStats &stats = physicsWorld.getAverageStepStats();
+    const std::pair<std::string, float> times[] = {
+        { "Step", stats.step },
+        { "Collide", stats.collide },
+        { "Solve", stats.solve },
+        { "Solve init", stats.solveInit },
+        { "Solve velocity", stats.solveVelocity },
+        { "Solve position", stats.solvePosition },
+        { "Broadphase", stats.broadphase },
+        { "Solve TOI", stats.solveTOI },
+    };
+    ImGuiOverlay::begin("Physics stats", 260.0f, 245.0f, 330.0f, 280.0f);
+    ImGuiOverlay::text("Average per step (us)");
+    for (const auto &time : times) {
+        std::stringstream timeStream;
+        timeStream << std::fixed << std::setprecision(1) << 1000.0f * time.second;
+        ImGuiOverlay::text(time.first + ": " + timeStream.str());
+    }
+    ImGuiOverlay::text("Bodies: " + std::to_string(stats.bodyCount));
+    ImGuiOverlay::text("Contacts: " + std::to_string(stats.contactCount));
+    ImGuiOverlay::text("Joints: " + std::to_string(stats.jointCount));
+    ImGuiOverlay::text("Broadphase proxies: " + std::to_string(stats.proxyCount));
+    ImGuiOverlay::end();
 }
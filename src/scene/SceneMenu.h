@@ -2,6 +2,7 @@
 #define SCENE_MENU_H_
 
 #include "Scene.h"
+#include "StepTimer.h"
 #include <string>
 #include <functional>
 
@@ -28,12 +29,34 @@ public:
     void setFps(unsigned int fps);
     void setAvgPhysicsSteps(unsigned int avgPhysicsSteps);
     void setWarningMessage(std::string message);
+    void setRealTimeFactor(float realTimeFactor);
+    /** Simulated seconds per wall-clock second, adjustable from the menu */
+    void setTimeScale(float timeScale);
+    float getTimeScale() const { return m_timeScale; }
+    /** Ignore the time scale and step as many times as possible between frames */
+    void setAsFastAsPossible(bool enabled);
+    bool isAsFastAsPossible() const { return m_asFastAsPossible; }
+    /** What to do when the steps can't keep up with the requested time scale */
+    void setOverloadPolicy(StepTimer::OverloadPolicy policy);
+    StepTimer::OverloadPolicy getOverloadPolicy() const;
+    void setOverloadStats(const StepTimer::OverloadStats &overloadStats);
 private:
+    void renderProfiler();
+    void renderPhysicsStats(const PhysicsWorld &physicsWorld);
+
     Scene*& m_currentScene;
     std::vector<std::pair<std::string, std::function<Scene*()>>> m_scenes;
     unsigned int m_fps = 0;
     unsigned int m_avgPhysicsSteps = 0;
     std::string m_warningMessage;
+    float m_realTimeFactor = 0.0f;
+    float m_timeScale = 1.0f;
+    bool m_asFastAsPossible = false;
+    bool m_coarserStepWhenOverloaded = false;
+    StepTimer::OverloadStats m_overloadStats;
+    bool m_profilerEnabled = false;
+    bool m_physicsStatsEnabled = false;
+    std::string m_profilerMessage;
 };
 
 #endif /* SCENE_MENU_H_ */
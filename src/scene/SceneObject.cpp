@@ -33,6 +33,27 @@ void SceneObject::updateRenderable()
     }
 }
 
+void SceneObject::storePreviousRenderState()
+{
+    if (m_renderableComponent) {
+        m_renderableComponent->storePreviousState();
+    }
+}
+
+void SceneObject::storeRenderableSnapshot(unsigned int slot)
+{
+    if (m_renderableComponent) {
+        m_renderableComponent->storeSnapshot(slot);
+    }
+}
+
+void SceneObject::renderSnapshot(unsigned int slot, float alpha)
+{
+    if (m_renderableComponent) {
+        m_renderableComponent->renderSnapshot(slot, alpha);
+    }
+}
+
 void SceneObject::updatePhysics()
 {
     if (m_physicsComponent) {
@@ -29,6 +29,9 @@ public:
     Scene *getScene() const { return m_scene; };
     void setController(ControllerComponent *controller);
     void updateRenderable();
+    void storePreviousRenderState();
+    void storeRenderableSnapshot(unsigned int slot);
+    void renderSnapshot(unsigned int slot, float alpha);
     void updatePhysics();
     void updateController(float stepTime);
     virtual void onFixedUpdate();
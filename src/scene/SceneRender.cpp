@@ -0,0 +1,37 @@
+#include "Scene.h"
+#include "SceneObject.h"
+#include "ImGuiMenu.h"
+#include "Profiler.h"
+
+#include <algorithm>
+
+/* The rendering part of Scene is kept apart from Scene.cpp so that bots2d_core
+ * does not depend on ImGui. It's built as part of bots2d_render. */
+void Scene::render()
+{
+    renderMenus();
+    Profiler::ScopedTimer timer(Profiler::Phase::SceneRender);
+    for (auto obj : m_objects) {
+        obj->updateRenderable();
+    }
+}
+
+void Scene::renderMenus()
+{
+    for (auto menu : m_menus) {
+        menu->render();
+    }
+}
+
+void Scene::renderSnapshot()
+{
+    Profiler::ScopedTimer timer(Profiler::Phase::SceneRender);
+    const unsigned int slot = m_snapshotIndex.acquire();
+    const SnapshotTiming &timing = m_snapshotTimings[slot];
+    const float secondsSincePublish = std::chrono::duration<float>(std::chrono::steady_clock::now() - timing.publishTime).count();
+    /* Never extrapolate beyond the latest step */
+    const float alpha = std::min(timing.alpha + secondsSincePublish * timing.alphaPerSecond, 1.0f);
+    for (auto obj : m_objects) {
+        obj->renderSnapshot(slot, alpha);
+    }
+}
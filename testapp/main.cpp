@@ -1,7 +1,70 @@
 #include "Bots2DTestApp.h"
+#include "HeadlessRunner.h"
+#include "BatchRunner.h"
+#include "Tracer.h"
+#include "SumobotTestScene.h"
+#include "PhysicsTestScene.h"
 
-int main()
+#include <string>
+#include <iostream>
+
+/**
+ * Run with "--headless [seconds]" to simulate the sumobot test scene without
+ * a window, e.g. on a machine without a display.
+ *
+ * Run with "--batch [count] [seconds] [--benchmark]" to simulate many instances of the
+ * physics test scene in parallel, optionally with the faster benchmark physics settings.
+ *
+ * Add "--trace <file>" last to write a Chrome trace (chrome://tracing) of the
+ * simulation, render and microcontroller threads on exit.
+ */
+int main(int argc, char *argv[])
 {
-    Bots2DTestApp app;
-    app.run();
+    if (argc > 2 && std::string(argv[argc - 2]) == "--trace") {
+        Tracer::start(argv[argc - 1]);
+        argc -= 2;
+    }
+
+    if (argc > 1 && std::string(argv[1]) == "--headless") {
+        const float simulatedSeconds = argc > 2 ? std::stof(argv[2]) : 180.0f;
+        HeadlessRunner runner(new SumobotTestScene());
+        runner.run(simulatedSeconds);
+        std::cout << "Simulated " << runner.getSimulatedSeconds() << " s ("
+                  << runner.getStepsTaken() << " steps) in "
+                  << runner.getElapsedSeconds() << " s" << std::endl;
+        const PhysicsWorld::StepStats &stats = runner.getScene()->getPhysicsWorld()->getAverageStepStats();
+        std::cout << "Average Box2D step " << stats.step << " ms (collide " << stats.collide
+                  << " ms, solve " << stats.solve << " ms), " << stats.bodyCount << " bodies, "
+                  << stats.contactCount << " contacts" << std::endl;
+        Tracer::stop();
+        return 0;
+    }
+
+    if (argc > 1 && std::string(argv[1]) == "--batch") {
+        const unsigned int sceneCount = argc > 2 ? std::stoul(argv[2]) : 100;
+        const float simulatedSeconds = argc > 3 ? std::stof(argv[3]) : 10.0f;
+        const bool benchmark = argc > 4 && std::string(argv[4]) == "--benchmark";
+        BatchRunner batchRunner;
+        batchRunner.registerSceneFactory([benchmark](unsigned int) {
+            Scene *scene = new PhysicsTestScene();
+            scene->getPhysicsWorld()->setBenchmarkEnabled(benchmark);
+            return scene;
+        });
+        const auto stepCounts = batchRunner.run<unsigned int>(sceneCount, simulatedSeconds,
+            [](Scene &scene, unsigned int) { return scene.getStepCount(); });
+        unsigned int totalSteps = 0;
+        for (const auto stepCount : stepCounts) {
+            totalSteps += stepCount;
+        }
+        std::cout << "Simulated " << sceneCount << " scenes (" << totalSteps << " steps) on "
+                  << batchRunner.getThreadCount() << " threads" << std::endl;
+        Tracer::stop();
+        return 0;
+    }
+
+    {
+        Bots2DTestApp app;
+        app.run();
+    }
+    Tracer::stop();
 }
@@ -3,6 +3,7 @@
 #include "robots/LineFollower.h"
 #include "shapes/RectObject.h"
 #include "playgrounds/LineFollowerPath.h"
+#include "PhysicsWorld.h"
 
 namespace {
     class LineFollowerController : public KeyboardController
@@ -86,8 +87,12 @@ LineFollowerTestScene::LineFollowerTestScene() :
     const glm::vec4 bgColor(1.0f, 1.0f, 1.0f, 1.0f);
     const glm::vec4 lineColor(0.0f, 0.0f, 0.0f, 1.0f);
     const float lineWidth = 0.01f;
+    const float floorMapCellSize = 0.002f;
     m_background = std::make_unique<RectObject>(this, bgColor, nullptr, glm::vec2{ 0.0f, 0.0f },
                                                 glm::vec2{ bgWidth, bgHeight }, 0.0f);
+    /* Detect the line from a floor map instead of a body per path quad */
+    m_physicsWorld->createFloorMap(glm::vec2{ -bgWidth / 2, -bgHeight / 2 },
+                                   glm::vec2{ bgWidth / 2, bgHeight / 2 }, floorMapCellSize);
 
     m_lineFollowerPath = std::make_unique<LineFollowerPath>(this, lineColor, lineWidth,
                                                             LineFollowerPath::getBlueprintPathPoints(LineFollowerPath::Blueprint::Mshaped));
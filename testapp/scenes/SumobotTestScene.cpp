@@ -139,6 +139,14 @@ void SumobotTestScene::createBackground()
 void SumobotTestScene::createTuningMenu()
 {
     m_tuningMenu = std::make_unique<ImGuiMenu>(this, "Tuning menu", 250.0f, 15.0f, 400.0f, 300.0f);
+    m_tuningMenu->addButton("Save physics state", [this]() {
+        m_physicsWorld->snapshot(m_physicsSnapshot);
+    });
+    m_tuningMenu->addButton("Restore physics state", [this]() {
+        if (!m_physicsSnapshot.bodies.empty()) {
+            m_physicsWorld->restore(m_physicsSnapshot);
+        }
+    });
     m_tuningMenu->addLabel("Sumobot 4W");
     auto fourWheelBot = m_fourWheelBot.get();
     m_tuningMenu->addSlider("Sideway fric. const.", 0.0f, 100.0f, fourWheelBot->getWheelSidewayFrictionConstant(),
@@ -225,8 +233,13 @@ void SumobotTestScene::createTuningMenu()
 }
 
 SumobotTestScene::SumobotTestScene() :
-    Scene("Test different types of mini-class sumobots", PhysicsWorld::Gravity::TopView, (1/1000.0f))
+    Scene("Test different types of mini-class sumobots", PhysicsWorld::Gravity::TopView, (1/1000.0f)),
+    m_background(std::make_unique<Background>())
 {
+    /* Sumobots ram each other at speed, so collide them continuously */
+    PhysicsWorld::Settings physicsSettings;
+    physicsSettings.bulletBodies = true;
+    m_physicsWorld->setSettings(physicsSettings);
     createBackground();
 
     const Dohyo::Specification dohyoSpec =
@@ -254,6 +267,8 @@ SumobotTestScene::SumobotTestScene() :
     voltageLines[Microcontroller::VoltageLine::B3] = { Microcontroller::VoltageLine::Type::Input, m_fourWheelBot->getVoltageLine(Sumobot::RangeSensorIndex::FrontRight) };
     voltageLines[Microcontroller::VoltageLine::B4] = { Microcontroller::VoltageLine::Type::Input, m_fourWheelBot->getVoltageLine(Sumobot::RangeSensorIndex::Right) };
     m_microcontroller = std::make_unique<NsumoMicrocontroller>(voltageLines);
+    m_microcontroller->setExecutionMode(Microcontroller::ExecutionMode::Coroutine);
+    m_microcontroller->setScheduler(getControllerScheduler());
     m_fourWheelBot->setController(m_microcontroller.get());
     m_microcontroller->start();
     m_fourWheelBot->setDebug(true);
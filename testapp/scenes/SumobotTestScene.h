@@ -25,7 +25,7 @@ private:
     void createBackground();
     void createTuningMenu();
     std::unique_ptr<ImGuiMenu> m_tuningMenu;
-    std::unique_ptr<Background> m_background = std::make_unique<Background>();
+    std::unique_ptr<Background> m_background;
     std::unique_ptr<Dohyo> m_dohyo;
     std::unique_ptr<Sumobot> m_fourWheelBot;
     std::unique_ptr<Sumobot> m_fourWheelBotOpponent;
@@ -34,6 +34,7 @@ private:
     std::unique_ptr<Sumobot> m_twoWheelRoundRedBot;
     std::unique_ptr<NsumoMicrocontroller> m_microcontroller;
     std::unique_ptr<KeyboardController> m_keyboardController;
+    PhysicsWorld::Snapshot m_physicsSnapshot;
 };
 
 #endif /* SUMOBOT_TEST_SCENE_H_ */